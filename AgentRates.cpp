@@ -0,0 +1,32 @@
+/**
+ * @file AgentRates.cpp
+ * @brief Implementation of the gamma-distributed rate multipliers
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "AgentRates.h"
+#include "Parallel.h"
+#include "Random.h"
+#include <random>
+#include <stdexcept>
+
+std::vector<float> gammaRates(std::size_t count, double shape, std::uint64_t seed, int threads) {
+    if (!(shape > 0.0) || !std::isfinite(shape)) {
+        throw std::invalid_argument("Gamma shape must be positive");
+    }
+    std::vector<float> rates(count);
+    const std::size_t block = std::size_t(1) << 16;
+    const std::size_t blocks = (count + block - 1) / block;
+    parallelFor(blocks, count < MIN_PARALLEL_BATCH ? 1 : threads, [&](std::size_t first, std::size_t last, int) {
+        for (std::size_t b = first; b < last; ++b) {
+            SplitMix64 rng(streamSeed(seed, b));
+            std::gamma_distribution<double> gamma(shape, 1.0 / shape);
+            const std::size_t end = std::min(count, (b + 1) * block);
+            for (std::size_t i = b * block; i < end; ++i) {
+                rates[i] = static_cast<float>(gamma(rng));
+            }
+        }
+    });
+    return rates;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file AliasTable.cpp
+ * @brief Implementation of the alias table construction
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "AliasTable.h"
+
+const std::size_t AliasTable::BLOCK_SIZE;
+
+double AliasTable::buildColumns(double* weights, std::uint32_t* work, std::size_t count, std::uint32_t first,
+                                Column* out) {
+    double total = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        total += weights[i];
+        out[i].acceptance = UINT32_MAX;
+        out[i].alias = first + static_cast<std::uint32_t>(i);
+    }
+    if (total <= 0.0) {
+        return 0.0;
+    }
+
+    // One work array holds both lists (small columns from the front, large
+    // ones from the back)
+    std::size_t smallEnd = 0;
+    std::size_t largeBegin = count;
+    for (std::size_t i = 0; i < count; ++i) {
+        weights[i] *= static_cast<double>(count) / total;
+        work[weights[i] < 1.0 ? smallEnd++ : --largeBegin] = static_cast<std::uint32_t>(i);
+    }
+    while (smallEnd > 0 && largeBegin < count) {
+        const std::uint32_t lower = work[--smallEnd];
+        const std::uint32_t upper = work[largeBegin];
+        out[lower].acceptance = static_cast<std::uint32_t>(std::min(weights[lower] * 4294967296.0, 4294967295.0));
+        out[lower].alias = first + upper;
+        weights[upper] -= 1.0 - weights[lower];
+        if (weights[upper] < 1.0) {
+            largeBegin++;
+            work[smallEnd++] = upper;
+        }
+    }
+    // Leftovers are 1 up to rounding and keep themselves (acceptance 2^32 - 1)
+    return total;
+}
+
+void AliasTable::buildTopLevel() {
+    std::vector<double> scratch(blockWeights);
+    std::vector<std::uint32_t> work(blockWeights.size());
+    blockColumns.resize(blockWeights.size());
+    totalWeight = buildColumns(scratch.data(), work.data(), scratch.size(), 0, blockColumns.data());
+}
@@ -0,0 +1,214 @@
+/**
+ * @file AliasTable.h
+ * @brief O(1) sampling from a discrete distribution (Vose's alias method)
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the AliasTable class used to draw contact targets in
+ * proportion to per-agent weights and the target age group of a contact.
+ */
+
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Two-level alias table over n outcomes with non-negative weights
+ *
+ * Outcomes are split into blocks of BLOCK_SIZE consecutive indices. Each block
+ * has its own alias table (Vose's method) and a small top-level table picks
+ * the block in proportion to its total weight, so outcome i is drawn with
+ * probability weight(i) / total exactly. A draw is two column lookups and two
+ * comparisons; the top level (8 bytes per block) stays in cache, so a table
+ * larger than the cache costs one miss per draw.
+ *
+ * Blocks are independent: a full build runs in parallel over blocks, and
+ * update() rebuilds only the blocks holding changed weights (O(BLOCK_SIZE)
+ * each) plus the top level (O(n / BLOCK_SIZE)). The table takes 8 bytes per
+ * outcome and the weights are not stored: builds read them through a callback.
+ */
+class AliasTable {
+public:
+    /// Outcomes per block
+    static const std::size_t BLOCK_SIZE = 4096;
+
+private:
+    struct Column {
+        std::uint32_t acceptance;           ///< Probability of keeping the column, times 2^32
+        std::uint32_t alias;                ///< Outcome (or block) taken when the column is rejected
+    };
+    std::vector<Column> columns;            ///< One column per outcome; aliases stay inside the block
+    std::vector<Column> blockColumns;       ///< Top-level table over blocks
+    std::vector<double> blockWeights;       ///< Total weight of each block
+    double totalWeight;                     ///< Sum of the weights
+
+    /**
+     * @brief Vose's method over one block of weights
+     *
+     * Columns below the mean are topped up from columns above it; a zero
+     * total leaves every column as its own outcome.
+     *
+     * @param weights Block weights (consumed as scratch)
+     * @param work Scratch of count entries
+     * @param count Number of outcomes in the block
+     * @param first Index of the block's first outcome (added to the aliases)
+     * @param out count columns
+     * @return Total weight of the block
+     */
+    static double buildColumns(double* weights, std::uint32_t* work, std::size_t count, std::uint32_t first,
+                               Column* out);
+
+    /**
+     * @brief Rebuilds the top level from the block weights
+     */
+    void buildTopLevel();
+
+    /**
+     * @brief Rebuilds the listed blocks from weight(i), in parallel over blocks
+     */
+    template <typename WeightFunction>
+    void rebuildBlocks(const std::vector<std::uint32_t>& blocks, WeightFunction& weight, int threads) {
+        std::atomic<bool> invalid(false);
+        parallelFor(blocks.size(), blocks.size() < 16 ? 1 : threads, [&](std::size_t begin, std::size_t end, int) {
+            std::vector<double> scratch(BLOCK_SIZE);
+            std::vector<std::uint32_t> work(BLOCK_SIZE);
+            for (std::size_t k = begin; k < end; ++k) {
+                const std::size_t first = static_cast<std::size_t>(blocks[k]) * BLOCK_SIZE;
+                const std::size_t members = std::min(BLOCK_SIZE, columns.size() - first);
+                for (std::size_t i = 0; i < members; ++i) {
+                    const double value = weight(first + i);
+                    // Workers cannot throw: bad weights are zeroed and reported afterwards
+                    if (!std::isfinite(value) || value < 0.0) {
+                        invalid = true;
+                        scratch[i] = 0.0;
+                    } else {
+                        scratch[i] = value;
+                    }
+                }
+                blockWeights[blocks[k]] = buildColumns(scratch.data(), work.data(), members,
+                                                       static_cast<std::uint32_t>(first), &columns[first]);
+            }
+        });
+        buildTopLevel();
+        if (invalid) {
+            throw std::invalid_argument("Alias table weights must be finite and non-negative");
+        }
+    }
+
+public:
+    /**
+     * @brief Empty table (no outcomes)
+     */
+    AliasTable() : totalWeight(0.0) {}
+
+    /**
+     * @brief Builds a table from a weight vector
+     *
+     * @throws std::invalid_argument as build()
+     */
+    explicit AliasTable(const std::vector<double>& weights, int threads = 1) : totalWeight(0.0) {
+        build(weights.size(), [&weights](std::size_t i) { return weights[i]; }, threads);
+    }
+
+    /**
+     * @brief Rebuilds the table from count weights given by weight(i)
+     *
+     * weight is called once per outcome, concurrently from several threads
+     * when threads != 1. A zero total leaves sampling valid but unweighted.
+     *
+     * @param count Number of outcomes (< 2^32)
+     * @param weight Callable returning the weight of outcome i as a double
+     * @param threads Worker threads (<= 0 selects the hardware concurrency)
+     * @throws std::invalid_argument if there are too many outcomes or a weight is
+     *         negative or not finite (such weights are then treated as 0)
+     */
+    template <typename WeightFunction>
+    void build(std::size_t count, WeightFunction weight, int threads = 1) {
+        if (count > UINT32_MAX) {
+            throw std::invalid_argument("Alias tables hold at most 2^32 - 1 outcomes");
+        }
+        columns.resize(count);
+        const std::size_t blocks = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        blockWeights.assign(blocks, 0.0);
+        std::vector<std::uint32_t> all(blocks);
+        std::iota(all.begin(), all.end(), 0u);
+        rebuildBlocks(all, weight, threads);
+    }
+
+    /**
+     * @brief Applies a batch of weight changes
+     *
+     * Only the blocks holding a listed outcome are rebuilt, then the top
+     * level, so batching a day's changes into one call rebuilds each dirty
+     * block once.
+     *
+     * @param changed Outcomes whose weight changed (repeats allowed)
+     * @param count Number of entries in changed
+     * @param weight Callable returning the current weight of outcome i
+     * @param threads Worker threads (<= 0 selects the hardware concurrency)
+     * @throws std::out_of_range if an outcome is out of range (before any change)
+     * @throws std::invalid_argument as build()
+     */
+    template <typename WeightFunction>
+    void update(const std::uint32_t* changed, std::size_t count, WeightFunction weight, int threads = 1) {
+        std::vector<std::uint32_t> dirty(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (changed[i] >= columns.size()) {
+                throw std::out_of_range("Alias table outcome out of range");
+            }
+            dirty[i] = static_cast<std::uint32_t>(changed[i] / BLOCK_SIZE);
+        }
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+        if (!dirty.empty()) {
+            rebuildBlocks(dirty, weight, threads);
+        }
+    }
+
+    /**
+     * @brief Draws one outcome
+     *
+     * The high word picks the block and the low word the outcome inside it,
+     * each by multiply-shift with the remainder as the acceptance draw, so
+     * the acceptance resolution is at worst max(blocks, BLOCK_SIZE) / 2^32.
+     *
+     * @param bits Uniform 64-bit random word
+     */
+    std::uint32_t sample(std::uint64_t bits) const {
+        const std::uint64_t outer = (bits >> 32) * static_cast<std::uint64_t>(blockColumns.size());
+        const Column& top = blockColumns[outer >> 32];
+        const std::size_t block = static_cast<std::uint32_t>(outer) < top.acceptance ? (outer >> 32) : top.alias;
+        const std::size_t first = block * BLOCK_SIZE;
+        const std::uint64_t members = std::min(BLOCK_SIZE, columns.size() - first);
+        const std::uint64_t inner = (bits & 0xffffffffu) * members;
+        const std::uint32_t column = static_cast<std::uint32_t>(first + (inner >> 32));
+        const Column& entry = columns[column];
+        return static_cast<std::uint32_t>(inner) < entry.acceptance ? column : entry.alias;
+    }
+
+    std::size_t size() const { return columns.size(); }
+    bool empty() const { return columns.empty(); }
+    double getTotalWeight() const { return totalWeight; }
+    double getBlockWeight(std::size_t block) const { return blockWeights[block]; }
+
+    /**
+     * @brief Gets the threshold of a column (times 2^32) inside its block's table
+     */
+    std::uint32_t getAcceptance(std::size_t column) const { return columns[column].acceptance; }
+
+    /**
+     * @brief Gets the alias of a column (an outcome of the same block)
+     */
+    std::uint32_t getAlias(std::size_t column) const { return columns[column].alias; }
+};
+
+#endif // ALIAS_TABLE_H
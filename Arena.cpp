@@ -0,0 +1,82 @@
+/**
+ * @file Arena.cpp
+ * @brief Slab allocation with huge-page fallbacks
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "Arena.h"
+#include <cstdint>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+const char* pagePolicyName(PagePolicy policy) {
+    switch (policy) {
+        case PagePolicy::TransparentHuge:
+            return "transparent-huge";
+        case PagePolicy::ExplicitHuge:
+            return "explicit-huge";
+        default:
+            return "default";
+    }
+}
+
+Arena::Arena(std::size_t bytes, PagePolicy requested)
+    : block(nullptr), blockBytes(0), slab(nullptr), capacity(bytes), used(0), policy(PagePolicy::Default) {
+#ifdef __linux__
+    // Mappings are page aligned, which satisfies the cache-line alignment
+    const std::size_t mappedBytes = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+#ifdef MAP_HUGETLB
+    if (requested == PagePolicy::ExplicitHuge && mappedBytes > 0) {
+        void* mapping = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapping != MAP_FAILED) {
+            block = mapping;
+            blockBytes = mappedBytes;
+            policy = PagePolicy::ExplicitHuge;
+        }
+    }
+#endif
+#ifdef MADV_HUGEPAGE
+    if (block == nullptr && requested != PagePolicy::Default && mappedBytes > 0) {
+        // Over-map by one huge page so the slab can start on a 2 MiB boundary
+        const std::size_t overMapped = mappedBytes + HUGE_PAGE;
+        void* mapping = mmap(nullptr, overMapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping != MAP_FAILED) {
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(mapping);
+            std::size_t lead = (HUGE_PAGE - address % HUGE_PAGE) % HUGE_PAGE;
+            if (lead > 0) {
+                munmap(mapping, lead);
+            }
+            if (HUGE_PAGE - lead > 0) {
+                munmap(static_cast<unsigned char*>(mapping) + lead + mappedBytes, HUGE_PAGE - lead);
+            }
+            block = static_cast<unsigned char*>(mapping) + lead;
+            blockBytes = mappedBytes;
+            policy = madvise(block, mappedBytes, MADV_HUGEPAGE) == 0 ? PagePolicy::TransparentHuge
+                                                                      : PagePolicy::Default;
+        }
+    }
+#endif
+#endif
+    if (block == nullptr) {
+        block = ::operator new(bytes + CACHE_LINE);
+    }
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block);
+    slab = static_cast<unsigned char*>(block) + (CACHE_LINE - address % CACHE_LINE) % CACHE_LINE;
+    allocationCounters().slabs.fetch_add(1, std::memory_order_relaxed);
+    allocationCounters().slabBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+Arena::~Arena() {
+#ifdef __linux__
+    if (blockBytes > 0) {
+        munmap(block, blockBytes);
+        return;
+    }
+#endif
+    ::operator delete(block);
+}
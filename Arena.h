@@ -0,0 +1,184 @@
+/**
+ * @file Arena.h
+ * @brief Slab arena for per-agent columns and capacity-keeping scratch buffers
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * Agent columns are carved out of one slab allocation, optionally backed by
+ * huge pages, and per-day scratch lists keep their capacity between days, so
+ * the steady-state day loop does not touch the heap. Both report to
+ * process-wide allocation counters.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Process-wide counters of simulation-layer allocations
+ */
+struct AllocationCounters {
+    std::atomic<std::uint64_t> slabs;           ///< Arena slabs allocated
+    std::atomic<std::uint64_t> slabBytes;       ///< Bytes in those slabs
+    std::atomic<std::uint64_t> scratchGrowths;  ///< Times a scratch buffer had to grow
+};
+
+/**
+ * @brief Gets the process-wide allocation counters
+ */
+inline AllocationCounters& allocationCounters() {
+    static AllocationCounters counters = {{0}, {0}, {0}};
+    return counters;
+}
+
+/**
+ * @brief Page backing requested for an arena slab
+ */
+enum class PagePolicy {
+    Default,           ///< Regular heap allocation
+    TransparentHuge,   ///< Anonymous mapping advised with MADV_HUGEPAGE (2 MiB pages when THP allows)
+    ExplicitHuge       ///< MAP_HUGETLB from the reserved hugetlbfs pool, else TransparentHuge
+};
+
+/**
+ * @brief Gets a printable name for a page policy
+ */
+const char* pagePolicyName(PagePolicy policy);
+
+/**
+ * @brief Storage options for agent columns
+ *
+ * The kernel places each page on the NUMA node of the thread that first
+ * touches it; without libnuma this is the only placement control. Engines
+ * with a parallel day loop (MetapopulationModel) first fill their columns
+ * with the partition parallelFor() gives that loop, so each thread's agents
+ * are local to it. Population steps its agents on one thread, so it touches
+ * its columns on the constructing thread and uses the threads only to refill
+ * them (resetToSusceptible()).
+ */
+struct StorageOptions {
+    PagePolicy pages;   ///< Requested page backing
+    int threads;        ///< Threads for bulk fills (<= 0 selects the hardware concurrency)
+
+    static const std::size_t MIN_PARALLEL_BYTES = std::size_t(1) << 20;   ///< Smaller columns are filled serially
+
+    /**
+     * @brief Default: regular pages, hardware concurrency for large columns
+     */
+    StorageOptions() : pages(PagePolicy::Default), threads(0) {}
+
+    /**
+     * @brief Gets the thread count for filling a column of the given size
+     */
+    int touchThreads(std::size_t columnBytes) const { return columnBytes < MIN_PARALLEL_BYTES ? 1 : threads; }
+};
+
+/**
+ * @brief Bump allocator over a single cache-line-aligned slab
+ *
+ * The slab is allocated once in the constructor; allocate() hands out aligned
+ * sub-ranges and never frees them individually. Memory is released with the
+ * arena. Huge-page requests degrade gracefully (explicit -> transparent ->
+ * regular pages); getPagePolicy() reports what was obtained.
+ */
+class Arena {
+private:
+    void* block;             ///< Allocation or mapping backing the slab
+    std::size_t blockBytes;  ///< Mapped length (0 for heap allocations)
+    unsigned char* slab;     ///< Aligned start of the slab
+    std::size_t capacity;    ///< Usable slab bytes
+    std::size_t used;        ///< Bytes handed out so far
+    PagePolicy policy;       ///< Page backing actually obtained
+
+public:
+    static const std::size_t CACHE_LINE = 64;   ///< Default alignment of every allocation
+    static const std::size_t HUGE_PAGE = std::size_t(2) << 20;   ///< Huge page size assumed for mappings
+
+    /**
+     * @brief Rounds a byte count up to whole cache lines
+     */
+    static std::size_t alignedSize(std::size_t bytes) {
+        return (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    }
+
+    /**
+     * @brief Allocates the slab
+     *
+     * Pages are not touched here; the owner's first writes place them.
+     *
+     * @param bytes Slab capacity (sum of alignedSize() of the planned allocations)
+     * @param requested Page backing to try first
+     * @throws std::bad_alloc if the slab cannot be allocated
+     */
+    explicit Arena(std::size_t bytes, PagePolicy requested = PagePolicy::Default);
+
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Carves an uninitialized, cache-line-aligned array out of the slab
+     *
+     * @param count Number of elements
+     * @return Pointer to the first element
+     * @throws std::bad_alloc if the slab is exhausted
+     */
+    template <typename T>
+    T* allocate(std::size_t count) {
+        std::size_t bytes = alignedSize(count * sizeof(T));
+        if (bytes > capacity - used) {
+            throw std::bad_alloc();
+        }
+        T* result = reinterpret_cast<T*>(slab + used);
+        used += bytes;
+        return result;
+    }
+
+    std::size_t getCapacity() const { return capacity; }
+    std::size_t getUsed() const { return used; }
+    PagePolicy getPagePolicy() const { return policy; }
+};
+
+/**
+ * @brief Append-only list that keeps its capacity across clear()
+ *
+ * Growth is counted in allocationCounters().scratchGrowths, so a steady-state
+ * loop can be checked for reallocations.
+ */
+template <typename T>
+class ScratchBuffer {
+private:
+    std::vector<T> items;   ///< Storage (capacity is never released)
+
+public:
+    void clear() { items.clear(); }
+
+    void push_back(const T& value) {
+        if (items.size() == items.capacity()) {
+            allocationCounters().scratchGrowths.fetch_add(1, std::memory_order_relaxed);
+        }
+        items.push_back(value);
+    }
+
+    void reserve(std::size_t count) {
+        if (count > items.capacity()) {
+            allocationCounters().scratchGrowths.fetch_add(1, std::memory_order_relaxed);
+            items.reserve(count);
+        }
+    }
+
+    std::size_t size() const { return items.size(); }
+    std::size_t capacity() const { return items.capacity(); }
+    bool empty() const { return items.empty(); }
+    const T* begin() const { return items.data(); }
+    const T* end() const { return items.data() + items.size(); }
+    const T& operator[](std::size_t i) const { return items[i]; }
+};
+
+#endif // ARENA_H
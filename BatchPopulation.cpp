@@ -0,0 +1,245 @@
+/**
+ * @file BatchPopulation.cpp
+ * @brief Implementation of the lane-batched SIR agent engine
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "BatchPopulation.h"
+#include "Parallel.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+const int BatchPopulation::LANES;
+const int BatchPopulation::MAX_DURATION;
+
+namespace {
+
+const int LANES = BatchPopulation::LANES;
+
+// Lane state byte: infected agents hold 1 + days left, so the day's decrement
+// turns an agent on its last day into RECOVERED
+const std::uint8_t SUSCEPTIBLE = 0;
+const std::uint8_t RECOVERED = 1;
+const std::uint8_t NEWLY_INFECTED = 0xFF;
+
+const std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+/// Marks a lane that has no run left
+const std::size_t NO_RUN = static_cast<std::size_t>(-1);
+
+/**
+ * @brief Maps the high 32 random bits to [0, range) by multiply-shift
+ */
+inline std::uint32_t scaledIndex(std::uint64_t bits, std::uint32_t range) {
+    return static_cast<std::uint32_t>(((bits >> 32) * range) >> 32);
+}
+
+/**
+ * @brief Fixed parameters shared by every lane of a run() call
+ */
+struct BatchParameters {
+    std::uint32_t size;             ///< Agents per population
+    std::int64_t contacts;          ///< Contacts per infected agent per day (capped at N - 1)
+    std::uint32_t threshold;        ///< Infection when the low 24 random bits are below this
+    std::uint8_t entryState;        ///< State of a new infection (1 + infectionDuration)
+    int initialInfections;          ///< Agents infected on day 0
+    int days;                       ///< Day limit
+    std::uint64_t seed;             ///< Base seed of the run streams
+};
+
+/**
+ * @brief LANES populations of one worker, interleaved agent by agent
+ */
+struct LaneGroup {
+    std::vector<std::uint8_t> states;   ///< states[agent * LANES + lane]
+    std::uint64_t rng[LANES];           ///< SplitMix64 state of each lane's run
+    std::size_t run[LANES];             ///< Run in each lane (NO_RUN when idle)
+    int day[LANES];
+    int susceptible[LANES];
+    int infected[LANES];
+    int peakInfected[LANES];
+    int peakDay[LANES];
+};
+
+/**
+ * @brief Starts run r in a lane: all susceptible, then Floyd's sampling of the initial infections
+ */
+void startRun(LaneGroup& group, int lane, std::size_t r, const BatchParameters& parameters) {
+    group.run[lane] = r;
+    group.rng[lane] = streamSeed(parameters.seed, r);
+    for (std::size_t cell = lane; cell < group.states.size(); cell += LANES) {
+        group.states[cell] = SUSCEPTIBLE;
+    }
+    const std::uint32_t size = parameters.size;
+    for (std::uint32_t j = size - parameters.initialInfections; j < size; ++j) {
+        const std::uint32_t t = scaledIndex(splitmix64(group.rng[lane]), j + 1);
+        group.rng[lane] += GOLDEN_GAMMA;
+        const std::uint32_t chosen = group.states[static_cast<std::size_t>(t) * LANES + lane] == SUSCEPTIBLE ? t : j;
+        group.states[static_cast<std::size_t>(chosen) * LANES + lane] = parameters.entryState;
+    }
+    group.day[lane] = 0;
+    group.susceptible[lane] = static_cast<int>(size) - parameters.initialInfections;
+    group.infected[lane] = parameters.initialInfections;
+    group.peakInfected[lane] = parameters.initialInfections;
+    group.peakDay[lane] = 0;
+}
+
+/**
+ * @brief Advances every busy lane by one day
+ */
+void simulateDay(LaneGroup& group, const BatchParameters& parameters) {
+    // Every infected agent makes the same number of uniform contacts, so who
+    // makes a contact does not matter: a lane's contacts are one run of draws
+    // from its stream. Contacts see the states at the start of the day; a new
+    // infection is marked NEWLY_INFECTED, which later contacts no longer count
+    // as susceptible.
+    std::uint8_t* states = group.states.data();
+    for (int l = 0; l < LANES; ++l) {
+        const std::int64_t contacts = group.run[l] != NO_RUN ? group.infected[l] * parameters.contacts : 0;
+        std::uint64_t rng = group.rng[l];
+        int newInfections = 0;
+        for (std::int64_t c = 0; c < contacts; ++c, rng += GOLDEN_GAMMA) {
+            const std::uint64_t bits = splitmix64(rng);
+            const std::size_t cell = static_cast<std::size_t>(scaledIndex(bits, parameters.size)) * LANES + l;
+            const std::uint8_t state = states[cell];
+            const bool infects = (state == SUSCEPTIBLE) &
+                                 (static_cast<std::uint32_t>(bits & 0xFFFFFF) < parameters.threshold);
+            // An OR rather than a select, which compilers may turn back into an unpredictable branch
+            states[cell] = static_cast<std::uint8_t>(state | (0 - static_cast<unsigned>(infects)));
+            newInfections += infects;
+        }
+        group.rng[l] = rng;
+        group.susceptible[l] -= newInfections;
+    }
+
+    // Progression and the infected count of every lane in one pass. Counts
+    // build up in byte counters over blocks of up to 255 agents, so a row is
+    // a few byte-vector operations whatever the optimization level.
+    int infected[LANES] = {0};
+    const std::uint8_t entry = parameters.entryState;
+    std::uint8_t* row = states;
+    for (std::uint32_t first = 0; first < parameters.size; first += 255) {
+        const std::uint32_t last = std::min(parameters.size, first + 255);
+        std::uint8_t blockInfected[LANES] = {0};
+        for (std::uint32_t i = first; i < last; ++i, row += LANES) {
+            for (int l = 0; l < LANES; ++l) {
+                const std::uint8_t state = row[l];
+                const std::uint8_t next = state == NEWLY_INFECTED ? entry
+                                        : state > RECOVERED ? static_cast<std::uint8_t>(state - 1) : state;
+                row[l] = next;
+                blockInfected[l] = static_cast<std::uint8_t>(blockInfected[l] + (next > RECOVERED));
+            }
+        }
+        for (int l = 0; l < LANES; ++l) {
+            infected[l] += blockInfected[l];
+        }
+    }
+    for (int l = 0; l < LANES; ++l) {
+        group.day[l]++;
+        group.infected[l] = infected[l];
+        if (infected[l] > group.peakInfected[l]) {
+            group.peakInfected[l] = infected[l];
+            group.peakDay[l] = group.day[l];
+        }
+    }
+}
+
+/**
+ * @brief Simulates runs [begin, end) in one group, refilling lanes as runs end
+ */
+void runGroup(LaneGroup& group, std::size_t begin, std::size_t end, const BatchParameters& parameters,
+              std::vector<RunOutcome>& outcomes) {
+    std::size_t next = begin;
+    int busy = 0;
+    for (int l = 0; l < LANES; ++l) {
+        group.run[l] = NO_RUN;
+        if (next < end) {
+            startRun(group, l, next++, parameters);
+            busy++;
+        }
+    }
+    while (busy > 0) {
+        simulateDay(group, parameters);
+        for (int l = 0; l < LANES; ++l) {
+            if (group.run[l] == NO_RUN || (group.infected[l] > 0 && group.day[l] < parameters.days)) {
+                continue;
+            }
+            RunOutcome& outcome = outcomes[group.run[l]];
+            outcome.finalSusceptible = group.susceptible[l];
+            outcome.finalInfected = group.infected[l];
+            outcome.finalRecovered = static_cast<int>(parameters.size) - group.susceptible[l] - group.infected[l];
+            outcome.peakInfected = group.peakInfected[l];
+            outcome.peakDay = group.peakDay[l];
+            outcome.days = group.day[l];
+            if (next < end) {
+                startRun(group, l, next++, parameters);
+            } else {
+                group.run[l] = NO_RUN;
+                busy--;
+            }
+        }
+    }
+}
+
+} // namespace
+
+BatchPopulation::BatchPopulation(int populationSize)
+    : size(populationSize), infectionProbability(0.0f), contactsPerDay(0), infectionDuration(1) {
+    if (populationSize <= 0) {
+        throw std::invalid_argument("Population size must be positive");
+    }
+}
+
+void BatchPopulation::setInfectionProbability(float probability) {
+    if (!(probability >= 0.0f && probability <= 1.0f)) {
+        throw std::invalid_argument("Infection probability must be in [0, 1]");
+    }
+    infectionProbability = probability;
+}
+
+void BatchPopulation::setContactsPerDay(int contacts) {
+    if (contacts < 0) {
+        throw std::invalid_argument("Contacts per day must be non-negative");
+    }
+    contactsPerDay = contacts;
+}
+
+void BatchPopulation::setInfectionDuration(int days) {
+    if (days < 1 || days > MAX_DURATION) {
+        throw std::invalid_argument("Batched runs need an infection duration of 1..253 days");
+    }
+    infectionDuration = days;
+}
+
+void BatchPopulation::run(int initialInfections, int days, std::uint64_t seed, std::size_t runs,
+                          std::vector<RunOutcome>& outcomes, int threads) const {
+    if (initialInfections < 1 || initialInfections > size) {
+        throw std::invalid_argument("Initial infections must be in 1..population size");
+    }
+    if (days <= 0) {
+        throw std::invalid_argument("Day limit must be positive");
+    }
+    outcomes.resize(runs);
+
+    BatchParameters parameters;
+    parameters.size = static_cast<std::uint32_t>(size);
+    parameters.contacts = std::min(contactsPerDay, size - 1);
+    parameters.threshold = static_cast<std::uint32_t>(std::ceil(static_cast<double>(infectionProbability) * 16777216.0));
+    parameters.entryState = static_cast<std::uint8_t>(infectionDuration + 1);
+    parameters.initialInfections = initialInfections;
+    parameters.days = days;
+    parameters.seed = seed;
+
+    // Lanes are allocated here so a failed allocation throws on the calling thread
+    const int partitions = static_cast<int>(std::min<std::size_t>(resolveThreadCount(threads), std::max<std::size_t>(runs, 1)));
+    std::vector<LaneGroup> groups(partitions);
+    for (LaneGroup& group : groups) {
+        group.states.resize(static_cast<std::size_t>(size) * LANES);
+    }
+    parallelFor(runs, partitions, [&](std::size_t begin, std::size_t end, int thread) {
+        runGroup(groups[thread], begin, end, parameters, outcomes);
+    });
+}
@@ -0,0 +1,112 @@
+/**
+ * @file BatchPopulation.h
+ * @brief Many small agent populations stepped together in lanes
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the BatchPopulation engine, which runs large numbers of
+ * independent small SIR agent simulations (replicate sweeps) side by side in
+ * one day loop, and RunOutcome, the summary it keeps of each run.
+ */
+
+#ifndef BATCH_POPULATION_H
+#define BATCH_POPULATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Summary of one finished run
+ */
+struct RunOutcome {
+    int finalSusceptible;   ///< S on the last day
+    int finalInfected;      ///< I on the last day (0 unless the day limit was reached)
+    int finalRecovered;     ///< R on the last day
+    int peakInfected;       ///< Highest I (day 0 included)
+    int peakDay;            ///< First day with the highest I
+    int days;               ///< Days simulated: the extinction day or the day limit
+};
+
+/**
+ * @brief Runs many independent SIR agent simulations side by side in lanes
+ *
+ * Dynamics are those of Population with homogeneous mixing: every infected
+ * agent makes min(contactsPerDay, N - 1) uniform contacts a day, infecting a
+ * susceptible contact with infectionProbability; infections take effect after
+ * the day's progression and last infectionDuration days. A run ends on
+ * extinction (no one infected) or at the day limit.
+ *
+ * LANES populations share one byte array, interleaved agent by agent
+ * (states[agent * LANES + lane]), where one byte holds both the compartment
+ * and the days left. Progression and counting are one elementwise pass over
+ * the array with per-lane counters, which the compiler vectorizes across
+ * lanes. Contacts need no scan for infected agents: every infected agent
+ * makes the same number of uniform contacts, so a lane's day is I * contacts
+ * draws from its stream. A lane whose run ends is refilled with the next run
+ * at once, so short runs (early fade-out) do not leave lanes idle behind long
+ * ones; lanes with no run left are masked out until the group drains.
+ *
+ * Run r draws from its own SplitMix64 stream streamSeed(seed, r), so every
+ * outcome depends only on (seed, r), not on the lane, the thread or the
+ * number of runs. The streams differ from Population's, so outcomes match
+ * the agent engine in distribution, not run by run.
+ */
+class BatchPopulation {
+public:
+    static const int LANES = 16;    ///< Populations stepped together
+
+    /// Longest infection the one-byte lane state can hold
+    static const int MAX_DURATION = 253;
+
+private:
+    int size;                       ///< Agents per population N
+    float infectionProbability;     ///< Probability of infection per contact
+    int contactsPerDay;             ///< Contacts per infected agent per day
+    int infectionDuration;          ///< Infectious days
+
+public:
+    /**
+     * @brief Constructor with no transmission (set the parameters before run())
+     *
+     * @param populationSize Agents in each population (must be > 0)
+     * @throws std::invalid_argument if populationSize <= 0
+     */
+    explicit BatchPopulation(int populationSize);
+
+    /**
+     * @param probability Infection probability per contact (0 <= p <= 1)
+     * @throws std::invalid_argument if probability is out of range
+     */
+    void setInfectionProbability(float probability);
+
+    /**
+     * @param contacts Contacts per infected agent per day (>= 0)
+     * @throws std::invalid_argument if contacts is negative
+     */
+    void setContactsPerDay(int contacts);
+
+    /**
+     * @param days Infectious days (1..MAX_DURATION)
+     * @throws std::invalid_argument if days is out of range
+     */
+    void setInfectionDuration(int days);
+
+    /**
+     * @brief Simulates runs 0..runs-1
+     *
+     * @param initialInfections Distinct random agents infected on day 0 (1..N)
+     * @param days Day limit of every run (> 0)
+     * @param seed Base seed; run r uses stream r of it
+     * @param runs Number of runs
+     * @param outcomes Resized to runs and filled with the results in run order
+     * @param threads Worker threads, each with its own lanes (<= 0 = hardware)
+     * @throws std::invalid_argument if initialInfections or days is out of range
+     */
+    void run(int initialInfections, int days, std::uint64_t seed, std::size_t runs,
+             std::vector<RunOutcome>& outcomes, int threads = 0) const;
+
+    int getPopulationSize() const { return size; }
+};
+
+#endif // BATCH_POPULATION_H
@@ -0,0 +1,1558 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Micro-benchmarks for the SIR simulation hot paths
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * Build and run with `make bench`. Pass a section name (e.g. `kernels`) to run
+ * a single benchmark; with no arguments every section runs in turn. `check`
+ * (`make check`) runs only the sections with cross-checks, at small sizes. Any
+ * failed cross-check makes the exit status nonzero.
+ */
+
+#include "AgentRates.h"
+#include "AliasTable.h"
+#include "Arena.h"
+#include "BatchPopulation.h"
+#include "CompartmentModel.h"
+#include "StateKernels.h"
+#include "GillespieModel.h"
+#include "TauLeapModel.h"
+#include "OdeModel.h"
+#include "HybridModel.h"
+#include "Intervention.h"
+#include "MetapopulationModel.h"
+#include "ContactNetwork.h"
+#include "ContactMatrix.h"
+#include "NetworkGenerator.h"
+#include "GraphOrdering.h"
+#include "Parallel.h"
+#include "Person.h"
+#include "Population.h"
+#include "QuantileSketch.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+std::atomic<std::uint64_t> heapAllocations(0);   ///< Calls to the global operator new
+
+} // namespace
+
+// Counting replacements of the global allocation functions (array and nothrow forms forward here).
+// Kept out of line: once inlined, GCC pairs malloc() / free() with the library
+// operators and reports a false -Wmismatched-new-delete
+__attribute__((noinline)) void* operator new(std::size_t bytes) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(bytes == 0 ? 1 : bytes)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+bool quickCheck = false;    ///< `check` mode: only the sections with cross-checks, at small sizes
+int failedChecks = 0;       ///< Cross-checks that failed so far (the exit status)
+
+/**
+ * @brief Size for the current mode: the full benchmark size, or the small one under `check`
+ */
+template <typename T>
+T scaled(T full, T quick) {
+    return quickCheck ? quick : full;
+}
+
+/**
+ * @brief Labels a cross-check outcome and counts it when it failed
+ */
+const char* verdict(bool passed, const char* pass, const char* fail) {
+    if (!passed) {
+        failedChecks++;
+    }
+    return passed ? pass : fail;
+}
+
+/**
+ * @brief Builds a state/days pair of arrays with a realistic mid-epidemic mix
+ */
+void makeAgents(std::size_t count, std::vector<std::uint8_t>& states, std::vector<std::uint8_t>& days) {
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<int> stateDis(0, 2);
+    std::uniform_int_distribution<int> dayDis(1, 5);
+    states.resize(count);
+    days.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        states[i] = static_cast<std::uint8_t>(stateDis(gen));
+        days[i] = states[i] == static_cast<std::uint8_t>(HealthState::Infected)
+                      ? static_cast<std::uint8_t>(dayDis(gen)) : 0;
+    }
+}
+
+/**
+ * @brief State progression and counting kernels: scalar vs. runtime-dispatched SIMD
+ */
+void benchStateKernels() {
+    // Odd tail exercises the scalar remainder
+    const std::size_t count = scaled<std::size_t>(64u * 1024u * 1024u + 13u, 1024u * 1024u + 13u);
+    const int repetitions = scaled(20, 1);
+    std::vector<std::uint8_t> baseStates, baseDays;
+    makeAgents(count, baseStates, baseDays);
+
+    std::cout << "--- State kernels (" << count << " agents, best ISA: "
+              << kernelIsaName(detectKernelIsa()) << ") ---" << std::endl;
+
+    const KernelIsa isas[] = {KernelIsa::Scalar, KernelIsa::AVX2, KernelIsa::AVX512};
+    std::vector<std::uint8_t> referenceStates, referenceDays;
+    StateCounts referenceCounts = {0, 0, 0};
+    for (KernelIsa requested : isas) {
+        KernelIsa isa = setKernelIsa(requested);
+        if (isa != requested) {
+            continue;
+        }
+        std::vector<std::uint8_t> states = baseStates;
+        std::vector<std::uint8_t> days = baseDays;
+
+        // Progression: reads and writes both arrays
+        StateCounts counts = {0, 0, 0};
+        Clock::time_point start = Clock::now();
+        for (int r = 0; r < repetitions; ++r) {
+            counts = progressAndCountStates(states.data(), days.data(), count);
+        }
+        double progressSeconds = secondsSince(start);
+
+        // Counting: reads the state array only
+        StateCounts histogram = {0, 0, 0};
+        start = Clock::now();
+        for (int r = 0; r < repetitions; ++r) {
+            histogram = countStates(states.data(), count);
+        }
+        double countSeconds = secondsSince(start);
+
+        bool consistent = histogram.susceptible == counts.susceptible &&
+                          histogram.infected == counts.infected &&
+                          histogram.recovered == counts.recovered;
+        if (isa == KernelIsa::Scalar) {
+            referenceStates = states;
+            referenceDays = days;
+            referenceCounts = counts;
+        } else {
+            consistent = consistent && states == referenceStates && days == referenceDays &&
+                         counts.susceptible == referenceCounts.susceptible &&
+                         counts.infected == referenceCounts.infected;
+        }
+
+        double progressBytes = 4.0 * count * repetitions;  // 2 arrays read + written
+        double countBytes = 1.0 * count * repetitions;
+        std::cout << std::left << std::setw(10) << kernelIsaName(isa) << std::right
+                  << std::fixed << std::setprecision(2)
+                  << " progress " << std::setw(7) << progressBytes / progressSeconds / 1e9 << " GB/s"
+                  << "   count " << std::setw(7) << countBytes / countSeconds / 1e9 << " GB/s"
+                  << "   " << verdict(consistent, "matches scalar", "MISMATCH") << std::endl;
+    }
+    setKernelIsa(detectKernelIsa());
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Outcome of one replicate, used to compare engines
+ */
+struct OutbreakSummary {
+    double attackRate;   ///< Fraction of the population ever infected
+    double peakInfected; ///< Largest daily prevalence
+    double peakDay;      ///< Day of the largest prevalence
+};
+
+/**
+ * @brief Runs one replicate of a configured engine to extinction (or 365 days)
+ */
+OutbreakSummary runToExtinction(EpidemicModel& model, int initialInfections) {
+    for (int i = 0; i < initialInfections; ++i) {
+        model.infectRandomPerson();
+    }
+    OutbreakSummary summary = {0.0, static_cast<double>(model.getInfectedCount()), 0.0};
+    while (model.getInfectedCount() > 0 && model.getCurrentDay() < 365) {
+        model.simulateOneDay();
+        if (model.getInfectedCount() > summary.peakInfected) {
+            summary.peakInfected = model.getInfectedCount();
+            summary.peakDay = model.getCurrentDay();
+        }
+    }
+    summary.attackRate = 1.0 - static_cast<double>(model.getSusceptibleCount()) / model.getPopulationSize();
+    return summary;
+}
+
+/**
+ * @brief Prints the mean outcome of a set of replicates
+ */
+void printOutbreakSummary(const char* label, const OutbreakSummary& total, int replicates, double seconds) {
+    std::cout << std::left << std::setw(22) << label << std::right << std::fixed
+              << std::setprecision(4) << " attack " << total.attackRate / replicates
+              << std::setprecision(0) << "  peak I " << std::setw(10) << total.peakInfected / replicates
+              << std::setprecision(1) << "  peak day " << std::setw(5) << total.peakDay / replicates
+              << std::setprecision(2) << "  " << std::setw(9) << 1e3 * seconds / replicates << " ms/run"
+              << std::endl;
+}
+
+/**
+ * @brief Small-population replicate throughput: Gillespie SSA vs. agent engine
+ */
+void benchGillespie() {
+    const int populationSize = 1000;
+    const int initialInfections = 5;
+    std::cout << "--- Replicates (N=" << populationSize << ", default parameters) ---" << std::endl;
+
+    const int gillespieReplicates = 20000;
+    long long events = 0;
+    double attackRate = 0.0;
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < gillespieReplicates; ++r) {
+        GillespieModel model(populationSize);
+        model.setInfectionRate(6 * 0.5);
+        model.setRecoveryRate(1.0 / 5);
+        model.setSeed(static_cast<unsigned int>(r + 1));
+        runToExtinction(model, initialInfections);
+        events += model.getEventCount();
+        attackRate += 1.0 - static_cast<double>(model.getSusceptibleCount()) / populationSize;
+    }
+    double seconds = secondsSince(start);
+    std::cout << std::fixed << std::setprecision(0)
+              << "gillespie  " << std::setw(10) << gillespieReplicates / seconds << " replicates/s  "
+              << std::setw(12) << events / seconds << " events/s  "
+              << std::setprecision(3) << "mean attack rate " << attackRate / gillespieReplicates << std::endl;
+
+    const int agentReplicates = 2000;
+    attackRate = 0.0;
+    start = Clock::now();
+    for (int r = 0; r < agentReplicates; ++r) {
+        Population model(populationSize);
+        model.setInfectionProbability(0.5f);
+        model.setContactsPerDay(6);
+        model.setInfectionDuration(5);
+        model.setSeed(static_cast<unsigned int>(r + 1));
+        runToExtinction(model, initialInfections);
+        attackRate += 1.0 - static_cast<double>(model.getSusceptibleCount()) / populationSize;
+    }
+    seconds = secondsSince(start);
+    std::cout << std::fixed << std::setprecision(0)
+              << "agent      " << std::setw(10) << agentReplicates / seconds << " replicates/s  "
+              << std::setw(12) << "" << "           "
+              << std::setprecision(3) << "mean attack rate " << attackRate / agentReplicates << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Tau-leap validation against the agent engine at N=1e5 and timing at N=1e9
+ */
+void benchTauLeap() {
+    // R0 = contacts * probability * duration = 2.4, so the outbreak does not saturate
+    const int contacts = 2;
+    const float probability = 0.3f;
+    const int duration = 4;
+    const int replicates = 10;
+    std::cout << "--- Tau-leap vs. agent engine (R0 = 2.4, mean of " << replicates << " runs) ---" << std::endl;
+
+    const int validationSize = 100000;
+    OutbreakSummary agentTotal = {0.0, 0.0, 0.0};
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < replicates; ++r) {
+        Population model(validationSize);
+        model.setInfectionProbability(probability);
+        model.setContactsPerDay(contacts);
+        model.setInfectionDuration(duration);
+        model.setSeed(static_cast<unsigned int>(r + 1));
+        OutbreakSummary summary = runToExtinction(model, 10);
+        agentTotal.attackRate += summary.attackRate;
+        agentTotal.peakInfected += summary.peakInfected;
+        agentTotal.peakDay += summary.peakDay;
+    }
+    printOutbreakSummary("agent      N=1e5", agentTotal, replicates, secondsSince(start));
+
+    const int sizes[] = {validationSize, 1000000000};
+    for (int populationSize : sizes) {
+        OutbreakSummary total = {0.0, 0.0, 0.0};
+        start = Clock::now();
+        for (int r = 0; r < replicates; ++r) {
+            TauLeapModel model(populationSize);
+            model.setInfectionRate(contacts * probability);
+            model.setRecoveryRate(1.0 / duration);
+            model.setSeed(static_cast<unsigned int>(r + 1));
+            OutbreakSummary summary = runToExtinction(model, 10);
+            total.attackRate += summary.attackRate;
+            total.peakInfected += summary.peakInfected;
+            total.peakDay += summary.peakDay;
+        }
+        printOutbreakSummary(populationSize == validationSize ? "tau-leap   N=1e5" : "tau-leap   N=1e9",
+                             total, replicates, secondsSince(start));
+    }
+    std::cout << "(final size depends only on R0; peak timing differs because agents recover after"
+              << " a fixed duration while the aggregate engines use exponential recovery)" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Lockstep RK45 throughput for calibration-style parameter sweeps
+ */
+void benchOde() {
+    const int parameterSets = 200000;
+    const double endTime = 180.0;
+    std::mt19937 gen(2025);
+    std::uniform_real_distribution<double> betaDis(0.2, 3.0);
+    std::uniform_real_distribution<double> gammaDis(0.1, 0.5);
+    std::vector<OdeParameters> parameters(parameterSets);
+    for (OdeParameters& p : parameters) {
+        p.infectionRate = betaDis(gen);
+        p.recoveryRate = gammaDis(gen);
+        p.initialInfectedFraction = 1e-6;
+    }
+
+    std::cout << "--- ODE (Dormand-Prince, " << parameterSets << " parameter sets, "
+              << BatchOdeSolver::LANES << " lanes, t = 0.." << endTime << ") ---" << std::endl;
+    BatchOdeSolver solver;
+    std::vector<OdeOutcome> outcomes;
+    Clock::time_point start = Clock::now();
+    solver.solve(parameters, endTime, outcomes);
+    double seconds = secondsSince(start);
+
+    // Final-size relation for epidemics that have run their course: s = exp(-R0 (1 - s))
+    double worstResidual = 0.0;
+    long long steps = 0;
+    for (std::size_t k = 0; k < outcomes.size(); ++k) {
+        steps += outcomes[k].steps;
+        if (outcomes[k].finalInfected < 1e-9) {
+            double r0 = parameters[k].infectionRate / parameters[k].recoveryRate;
+            double s = outcomes[k].finalSusceptible;
+            double residual = std::fabs(s - (1.0 - 1e-6) * std::exp(-r0 * (1.0 - s)));
+            worstResidual = std::max(worstResidual, residual);
+        }
+    }
+    std::cout << std::fixed << std::setprecision(0) << parameterSets / seconds << " parameter-sets/s  "
+              << std::setprecision(1) << static_cast<double>(steps) / parameterSets << " steps/set  "
+              << std::scientific << std::setprecision(1) << "worst final-size residual " << worstResidual
+              << std::defaultfloat << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Hybrid agent/chain-binomial engine vs. the pure agent engine
+ */
+void benchHybrid() {
+    const int populationSize = 2000000;
+    const int replicates = 3;
+    std::cout << "--- Hybrid vs. agent engine (N=" << populationSize << ", R0 = 2.4, mean of "
+              << replicates << " runs) ---" << std::endl;
+
+    OutbreakSummary agentTotal = {0.0, 0.0, 0.0};
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < replicates; ++r) {
+        Population model(populationSize);
+        model.setInfectionProbability(0.3f);
+        model.setContactsPerDay(2);
+        model.setInfectionDuration(4);
+        model.setSeed(static_cast<unsigned int>(r + 1));
+        OutbreakSummary summary = runToExtinction(model, 10);
+        agentTotal.attackRate += summary.attackRate;
+        agentTotal.peakInfected += summary.peakInfected;
+        agentTotal.peakDay += summary.peakDay;
+    }
+    double agentSeconds = secondsSince(start);
+    printOutbreakSummary("agent", agentTotal, replicates, agentSeconds);
+
+    OutbreakSummary hybridTotal = {0.0, 0.0, 0.0};
+    int switches = 0;
+    start = Clock::now();
+    for (int r = 0; r < replicates; ++r) {
+        HybridModel model(populationSize);
+        model.setInfectionProbability(0.3f);
+        model.setContactsPerDay(2);
+        model.setInfectionDuration(4);
+        model.setSeed(static_cast<unsigned int>(r + 1));
+        OutbreakSummary summary = runToExtinction(model, 10);
+        hybridTotal.attackRate += summary.attackRate;
+        hybridTotal.peakInfected += summary.peakInfected;
+        hybridTotal.peakDay += summary.peakDay;
+        switches += model.getSwitchCount();
+    }
+    double hybridSeconds = secondsSince(start);
+    printOutbreakSummary("hybrid (1% / 0.1%)", hybridTotal, replicates, hybridSeconds);
+    std::cout << std::fixed << std::setprecision(1) << "speedup " << agentSeconds / hybridSeconds
+              << "x, " << 1.0 * switches / replicates << " representation switches per run" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief CSR network loading and network transmission day loop
+ */
+void benchNetwork() {
+    const std::uint32_t nodes = 2000000;
+    const std::uint64_t edges = 20000000;
+    const std::string path = "/tmp/sir_benchmark_edges.bin";
+    {
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<std::uint32_t> nodeDis(0, nodes - 1);
+        std::ofstream out(path.c_str(), std::ios::binary);
+        std::vector<std::uint32_t> buffer;
+        buffer.reserve(1 << 20);
+        for (std::uint64_t e = 0; e < edges; ++e) {
+            buffer.push_back(nodeDis(gen));
+            buffer.push_back(nodeDis(gen));
+            if (buffer.size() == buffer.capacity() || e + 1 == edges) {
+                out.write(reinterpret_cast<const char*>(buffer.data()),
+                          static_cast<std::streamsize>(buffer.size() * sizeof(std::uint32_t)));
+                buffer.clear();
+            }
+        }
+    }
+
+    std::cout << "--- Contact network (" << nodes << " nodes, " << edges << " random edges) ---" << std::endl;
+    Clock::time_point start = Clock::now();
+    auto network = std::make_shared<ContactNetwork>(ContactNetwork::loadEdgeList(path, nodes));
+    double loadSeconds = secondsSince(start);
+    std::remove(path.c_str());
+    std::cout << std::fixed << std::setprecision(2) << "load (mmap, 2 passes) " << loadSeconds << " s, "
+              << edges / loadSeconds / 1e6 << " M edges/s, "
+              << static_cast<double>(network->getMemoryBytes()) / network->getEdgeCount() << " bytes/edge"
+              << std::endl;
+
+    Population population(static_cast<int>(nodes));
+    population.setInfectionProbability(0.05f);
+    population.setInfectionDuration(5);
+    population.setContactNetwork(network);
+    population.setSeed(11);
+    for (int i = 0; i < 100; ++i) {
+        population.infectRandomPerson();
+    }
+    start = Clock::now();
+    while (population.getInfectedCount() > 0 && population.getCurrentDay() < 365) {
+        population.simulateOneDay();
+    }
+    double runSeconds = secondsSince(start);
+    std::cout << "network epidemic: " << population.getCurrentDay() << " days in " << runSeconds << " s ("
+              << 1e3 * runSeconds / population.getCurrentDay() << " ms/day), attack rate "
+              << std::setprecision(3)
+              << 1.0 - static_cast<double>(population.getSusceptibleCount()) / nodes << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Parallel synthetic network generation in edges/second
+ */
+void benchGenerators() {
+    const int threads = resolveThreadCount(0);
+    const std::uint32_t nodes = scaled(1000000u, 20000u);
+    std::cout << "--- Network generators (" << nodes << " nodes, mean degree 10, " << threads
+              << " thread(s)) ---" << std::endl;
+    const NetworkModel models[] = {NetworkModel::ErdosRenyi, NetworkModel::BarabasiAlbert,
+                                   NetworkModel::WattsStrogatz};
+    const char* names[] = {"erdos-renyi", "barabasi-albert", "watts-strogatz"};
+    for (int m = 0; m < 3; ++m) {
+        NetworkSpec spec;
+        spec.model = models[m];
+        spec.nodes = nodes;
+        spec.meanDegree = 10.0;
+        spec.seed = 99;
+        NetworkGenerator generator(spec);
+
+        Clock::time_point start = Clock::now();
+        ContactNetwork network = generator.build(threads);
+        double seconds = secondsSince(start);
+        const int otherThreads = threads == 1 ? 4 : 1;
+        ContactNetwork other = generator.build(otherThreads);
+        bool deterministic = other.getOffsets() == network.getOffsets() &&
+                             other.getNeighbors() == network.getNeighbors();
+
+        const std::string path = "/tmp/sir_benchmark_generated.bin";
+        start = Clock::now();
+        std::uint64_t streamed = generator.writeEdgeList(path, threads);
+        double streamSeconds = secondsSince(start);
+        std::remove(path.c_str());
+
+        std::cout << std::left << std::setw(16) << names[m] << std::right << std::fixed
+                  << std::setprecision(2) << " CSR " << std::setw(6) << network.getEdgeCount() / seconds / 1e6
+                  << " M edges/s (" << network.getEdgeCount() << " edges, max degree ";
+        std::uint32_t maxDegree = 0;
+        for (std::uint32_t i = 0; i < network.getNodeCount(); ++i) {
+            maxDegree = std::max(maxDegree, network.getDegree(i));
+        }
+        std::cout << maxDegree << ")  stream " << std::setw(6) << streamed / streamSeconds / 1e6
+                  << " M edges/s  " << verdict(deterministic, "identical with ", "DIFFERS with ")
+                  << otherThreads << " thread(s)"
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Hardware event counter for the calling thread (perf_event_open)
+ *
+ * Reports -1 when performance counters are unavailable (containers,
+ * perf_event_paranoid, non-Linux kernels).
+ */
+class PerfCounter {
+private:
+    int fd;
+
+public:
+    PerfCounter(std::uint32_t type, std::uint64_t config) : fd(-1) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    ~PerfCounter() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    void start() {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    long long stop() {
+        long long misses = -1;
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &misses, sizeof(misses)) != static_cast<ssize_t>(sizeof(misses))) {
+                misses = -1;
+            }
+        }
+        return misses;
+    }
+};
+
+/**
+ * @brief Network transmission day loop before and after agent reordering
+ *
+ * A Watts-Strogatz graph has strong locality, so its labels are shuffled first
+ * to mimic a real network with arbitrary IDs; reordering should recover it.
+ */
+void benchReorder() {
+    const std::uint32_t nodes = 2000000;
+    NetworkSpec spec;
+    spec.model = NetworkModel::WattsStrogatz;
+    spec.nodes = nodes;
+    spec.meanDegree = 10.0;
+    spec.rewiringProbability = 0.05;
+    spec.seed = 5;
+    ContactNetwork lattice = NetworkGenerator(spec).build();
+    std::vector<std::uint32_t> shuffle(nodes);
+    for (std::uint32_t i = 0; i < nodes; ++i) {
+        shuffle[i] = i;
+    }
+    std::shuffle(shuffle.begin(), shuffle.end(), std::mt19937(3));
+    auto network = std::make_shared<ContactNetwork>(relabelNetwork(lattice, shuffle));
+
+    std::cout << "--- Agent reordering (Watts-Strogatz, " << nodes << " nodes, shuffled IDs) ---" << std::endl;
+    const NodeOrdering orderings[] = {NodeOrdering::None, NodeOrdering::Degree, NodeOrdering::ReverseCuthillMcKee};
+    for (NodeOrdering ordering : orderings) {
+        Population population(static_cast<int>(nodes));
+        population.setInfectionProbability(0.1f);
+        population.setInfectionDuration(5);
+        population.setContactNetwork(network);
+        Clock::time_point start = Clock::now();
+        population.reorderAgents(ordering);
+        double reorderSeconds = secondsSince(start);
+        population.setSeed(11);
+        for (int i = 0; i < 100; ++i) {
+            population.infectRandomPerson();
+        }
+
+        PerfCounter counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        counter.start();
+        start = Clock::now();
+        while (population.getInfectedCount() > 0 && population.getCurrentDay() < 365) {
+            population.simulateOneDay();
+        }
+        double runSeconds = secondsSince(start);
+        long long misses = counter.stop();
+
+        const int days = std::max(population.getCurrentDay(), 1);
+        std::cout << std::left << std::setw(7) << nodeOrderingName(ordering) << std::right << std::fixed
+                  << std::setprecision(2) << " reorder " << std::setw(5) << reorderSeconds << " s  "
+                  << std::setw(4) << population.getCurrentDay() << " days " << std::setw(6)
+                  << 1e3 * runSeconds / days << " ms/day  cache misses/day ";
+        if (misses >= 0) {
+            std::cout << std::setprecision(1) << static_cast<double>(misses) / days / 1e6 << " M";
+        } else {
+            std::cout << "n/a";
+        }
+        std::cout << std::setprecision(3) << "  attack rate "
+                  << 1.0 - static_cast<double>(population.getSusceptibleCount()) / nodes << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Metapopulation engine: thread-count determinism, one-patch cross-check, scale
+ */
+void benchMetapopulation() {
+    std::cout << "--- Metapopulation ---" << std::endl;
+    {
+        const int size = scaled(1000000, 100000);
+        const int patches = scaled(1000, 100);
+        MetapopulationModel serial(MetapopulationModel::evenPatchSizes(size, patches));
+        MetapopulationModel threaded(MetapopulationModel::evenPatchSizes(size, patches));
+        serial.setThreadCount(1);
+        threaded.setThreadCount(4);
+        bool identical = true;
+        for (MetapopulationModel* model : {&serial, &threaded}) {
+            model->setInfectionProbability(0.1f);
+            model->setContactsPerDay(10);
+            model->setInfectionDuration(5);
+            model->setMobility(MobilityMatrix::grid(patches, 0.02));
+            model->setSeed(21);
+            model->infectRandomPersonInPatch(0);
+        }
+        for (int d = 0; d < 60; ++d) {
+            serial.simulateOneDay();
+            threaded.simulateOneDay();
+            identical = identical && serial.getInfectedCount() == threaded.getInfectedCount() &&
+                        serial.getSusceptibleCount() == threaded.getSusceptibleCount();
+        }
+        std::cout << size << " agents, " << patches << " patches, 60 days: 1 vs 4 threads "
+                  << verdict(identical, "identical", "DIFFER") << ", attack rate " << std::fixed
+                  << std::setprecision(3)
+                  << 1.0 - static_cast<double>(serial.getSusceptibleCount()) / serial.getPopulationSize()
+                  << std::endl;
+    }
+    if (quickCheck) {
+        std::cout << std::endl;
+        return;
+    }
+    {
+        const int replicates = 10;
+        const int size = 100000;
+        double onePatch = 0.0;
+        double agents = 0.0;
+        for (int r = 0; r < replicates; ++r) {
+            MetapopulationModel model(MetapopulationModel::evenPatchSizes(size, 1));
+            model.setInfectionProbability(0.05f);
+            model.setContactsPerDay(6);
+            model.setInfectionDuration(5);
+            model.setSeed(100 + r);
+            Population population(size);
+            population.setInfectionProbability(0.05f);
+            population.setContactsPerDay(6);
+            population.setInfectionDuration(5);
+            population.setSeed(100 + r);
+            onePatch += runToExtinction(model, 20).attackRate;
+            agents += runToExtinction(population, 20).attackRate;
+        }
+        std::cout << "one patch vs Population (N=1e5, R0=1.5, 10 replicates): attack rate " << std::setprecision(3)
+                  << onePatch / replicates << " vs " << agents / replicates << std::endl;
+    }
+    {
+        const int patches = 10000;
+        const int size = 100000000;
+        const int days = 20;
+        Clock::time_point start = Clock::now();
+        MetapopulationModel model(MetapopulationModel::evenPatchSizes(size, patches));
+        double buildSeconds = secondsSince(start);
+        model.setInfectionProbability(0.05f);
+        model.setContactsPerDay(8);
+        model.setInfectionDuration(5);
+        model.setMobility(MobilityMatrix::grid(patches, 0.05));
+        model.setSeed(8);
+        for (int i = 0; i < 10000; ++i) {
+            model.infectRandomPerson();
+        }
+        start = Clock::now();
+        for (int d = 0; d < days; ++d) {
+            model.simulateOneDay();
+        }
+        double seconds = secondsSince(start);
+        std::cout << "1e8 agents, 10000 patches (" << model.getMobility().getFlowCount() << " flows, "
+                  << resolveThreadCount(0) << " thread(s)): build " << std::setprecision(2) << buildSeconds
+                  << " s, " << days << " days in " << seconds << " s (" << 1e3 * seconds / days
+                  << " ms/day), infected " << model.getInfectedCount() << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Heap allocations of the agent day loop (counted through the global operator new)
+ */
+void benchAllocations() {
+    const int size = scaled(1000000, 100000);
+    std::cout << "--- Allocations (agent engine, N=" << size << ") ---" << std::endl;
+    std::uint64_t before = heapAllocations.load();
+    std::uint64_t slabsBefore = allocationCounters().slabs.load();
+    Population population(size);
+    population.setInfectionProbability(0.05f);
+    population.setContactsPerDay(6);
+    population.setInfectionDuration(5);
+    population.setSeed(4);
+    for (int i = 0; i < 100; ++i) {
+        population.infectRandomPerson();
+    }
+    std::uint64_t construction = heapAllocations.load() - before;
+
+    // Until well past the peak the scratch list may still grow; afterwards incidence only declines
+    std::uint64_t growthsBefore = allocationCounters().scratchGrowths.load();
+    before = heapAllocations.load();
+    int peakInfected = 0;
+    while ((population.getInfectedCount() > peakInfected / 2 || peakInfected < 1000) &&
+           population.getInfectedCount() > 0 && population.getCurrentDay() < 365) {
+        population.simulateOneDay();
+        peakInfected = std::max(peakInfected, population.getInfectedCount());
+    }
+    std::uint64_t growthDays = population.getCurrentDay();
+    std::uint64_t growthAllocations = heapAllocations.load() - before;
+    std::uint64_t growths = allocationCounters().scratchGrowths.load() - growthsBefore;
+
+    before = heapAllocations.load();
+    Clock::time_point start = Clock::now();
+    int steadyDays = 0;
+    while (population.getInfectedCount() > 0 && population.getCurrentDay() < 365) {
+        population.simulateOneDay();
+        steadyDays++;
+    }
+    double seconds = secondsSince(start);
+    std::uint64_t steadyAllocations = heapAllocations.load() - before;
+
+    std::cout << "construction: " << construction << " heap allocation(s), "
+              << allocationCounters().slabs.load() - slabsBefore << " slab" << std::endl;
+    std::cout << "to peak/2:    " << growthDays << " days, " << growthAllocations << " heap allocations ("
+              << growths << " scratch growths)" << std::endl;
+    std::cout << "after peak:   " << steadyDays << " days, " << steadyAllocations << " heap allocations "
+              << verdict(steadyAllocations == 0, "(zero, as expected)", "(EXPECTED ZERO)") << ", " << std::fixed
+              << std::setprecision(2) << 1e3 * seconds / std::max(steadyDays, 1) << " ms/day" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Resident anonymous huge-page memory of this process in KiB (-1 if unknown)
+ */
+long long anonHugePagesKiB() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string key;
+    long long value = 0;
+    while (smaps >> key) {
+        if (key == "AnonHugePages:") {
+            smaps >> value;
+            return value;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Agent day loop with regular, transparent-huge and explicit-huge page backing
+ *
+ * Homogeneous mixing with many infected individuals makes every contact a
+ * random access into the 200 MB state column, which is TLB-bound on small pages.
+ */
+void benchPages() {
+    const int size = 100000000;
+    const int threads = resolveThreadCount(0);
+    std::cout << "--- Page backing (agent engine, N=" << size << ", first touch on " << threads
+              << " thread(s)) ---" << std::endl;
+    const PagePolicy policies[] = {PagePolicy::Default, PagePolicy::TransparentHuge, PagePolicy::ExplicitHuge};
+    for (PagePolicy requested : policies) {
+        StorageOptions storage;
+        storage.pages = requested;
+        storage.threads = threads;
+        long long hugeBefore = anonHugePagesKiB();
+        Clock::time_point start = Clock::now();
+        Population population(size, storage);
+        double constructSeconds = secondsSince(start);
+        long long hugeKiB = anonHugePagesKiB() - hugeBefore;
+        population.setInfectionProbability(0.02f);
+        population.setContactsPerDay(10);
+        population.setInfectionDuration(5);
+        population.setSeed(6);
+        for (int i = 0; i < 1000000; ++i) {
+            population.infectRandomPerson();
+        }
+
+        PerfCounter tlbMisses(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        const int days = 4;
+        tlbMisses.start();
+        start = Clock::now();
+        for (int d = 0; d < days; ++d) {
+            population.simulateOneDay();
+        }
+        double seconds = secondsSince(start);
+        long long misses = tlbMisses.stop();
+
+        std::cout << std::left << std::setw(17) << pagePolicyName(requested) << std::right << " -> "
+                  << std::left << std::setw(17) << pagePolicyName(population.getPagePolicy()) << std::right
+                  << std::fixed << std::setprecision(3) << " construct " << constructSeconds << " s  huge pages "
+                  << (hugeKiB >= 0 ? std::to_string(hugeKiB / 1024) + " MiB" : std::string("n/a"))
+                  << std::setprecision(1) << "  " << 1e3 * seconds / days << " ms/day  dTLB misses/day ";
+        if (misses >= 0) {
+            std::cout << static_cast<double>(misses) / days / 1e6 << " M";
+        } else {
+            std::cout << "n/a";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Time to first day of a 10^9-agent population (construction, seeding, day 1, reset)
+ */
+void benchStartup() {
+    const int size = 1000000000;
+    const int hardware = resolveThreadCount(0);
+    std::cout << "--- Startup (agent engine, N=" << size << ") ---" << std::endl;
+    const int threadCounts[] = {1, hardware};
+    for (int t = 0; t < (hardware > 1 ? 2 : 1); ++t) {
+        StorageOptions storage;
+        storage.threads = threadCounts[t];
+        storage.pages = PagePolicy::TransparentHuge;
+        Clock::time_point start = Clock::now();
+        Population population(size, storage);
+        double constructSeconds = secondsSince(start);
+        population.setInfectionProbability(0.05f);
+        population.setContactsPerDay(6);
+        population.setInfectionDuration(5);
+        population.setSeed(9);
+        start = Clock::now();
+        population.infectRandomPeople(1000);
+        double seedSeconds = secondsSince(start);
+        start = Clock::now();
+        population.simulateOneDay();
+        double daySeconds = secondsSince(start);
+        start = Clock::now();
+        population.resetToSusceptible();
+        double resetSeconds = secondsSince(start);
+
+        std::cout << std::setw(2) << threadCounts[t] << " thread(s): construct " << std::fixed
+                  << std::setprecision(3) << constructSeconds << " s (" << std::setprecision(1)
+                  << 2.0 * size / constructSeconds / 1e9 << " GB/s)  seed 1000 " << std::setprecision(3)
+                  << 1e3 * seedSeconds << " ms  day 1 " << daySeconds << " s  time to first day "
+                  << constructSeconds + seedSeconds + daySeconds << " s  reset " << resetSeconds << " s"
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Ensemble throughput of small populations: one engine per replicate vs reset(seed)
+ */
+void benchReplicates() {
+    const int replicates = scaled(2000, 50);
+    SimulationConfig config(10000, 10, 365, 0.05f, 6, 5);
+    std::cout << "--- Replicates (N=" << config.populationSize << ", " << replicates << " replicates) ---"
+              << std::endl;
+    const SimulationEngine engines[] = {SimulationEngine::Agent, SimulationEngine::Hybrid, SimulationEngine::TauLeap};
+    for (SimulationEngine engine : engines) {
+        config.engine = engine;
+
+        // Fresh engine per replicate
+        std::uint64_t before = heapAllocations.load();
+        long long freshSusceptible = 0;
+        Clock::time_point start = Clock::now();
+        for (int r = 0; r < replicates; ++r) {
+            config.seed = static_cast<unsigned int>(r + 1);
+            SIRSimulation simulation(config);
+            simulation.runReplicate();
+            freshSusceptible += simulation.getModel().getSusceptibleCount();
+        }
+        double freshSeconds = secondsSince(start);
+        std::uint64_t freshAllocations = heapAllocations.load() - before;
+
+        // One engine, reset in place; the first replicate warms up the buffers
+        config.seed = 1;
+        SIRSimulation simulation(config);
+        simulation.runReplicate();
+        long long resetSusceptible = simulation.getModel().getSusceptibleCount();
+        before = heapAllocations.load();
+        start = Clock::now();
+        for (int r = 1; r < replicates; ++r) {
+            simulation.reset(static_cast<unsigned int>(r + 1));
+            simulation.runReplicate();
+            resetSusceptible += simulation.getModel().getSusceptibleCount();
+        }
+        double resetSeconds = secondsSince(start) * replicates / (replicates - 1);
+        std::uint64_t resetAllocations = heapAllocations.load() - before;
+
+        std::cout << std::left << std::setw(9) << simulationEngineName(engine) << std::right << std::fixed
+                  << std::setprecision(0) << " construct " << replicates / freshSeconds << " runs/s ("
+                  << std::setprecision(1) << static_cast<double>(freshAllocations) / replicates
+                  << " allocs/run)  reset " << std::setprecision(0) << replicates / resetSeconds << " runs/s ("
+                  << std::setprecision(1) << static_cast<double>(resetAllocations) / (replicates - 1) << " allocs/run, "
+                  << verdict(resetAllocations == 0, "as expected", "EXPECTED ZERO") << ")  speedup " << std::setprecision(2)
+                  << freshSeconds / resetSeconds << "x  "
+                  << verdict(freshSusceptible == resetSusceptible, "same trajectories", "TRAJECTORIES DIFFER")
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Exact seeding of k distinct agents (Floyd, then selection sampling on a seeded population)
+ */
+void benchSeeding() {
+    const int size = scaled(100000000, 1000000);
+    std::cout << "--- Seeding (agent engine, N=" << size << ") ---" << std::endl;
+    Population population(size);
+    population.setInfectionDuration(5);
+    const int counts[] = {size / 100000, size / 1000, size / 100, size / 10};
+    for (int count : counts) {
+        population.reset(static_cast<unsigned int>(count));
+        Clock::time_point start = Clock::now();
+        population.infectRandomPeople(count);
+        double seconds = secondsSince(start);
+        // With replacement, about k^2 / 2N draws would have repeated an earlier one
+        double shortfall = static_cast<double>(count) * count / (2.0 * size);
+        std::cout << "k=" << std::setw(8) << count << "  Floyd " << std::fixed << std::setprecision(2) << std::setw(8)
+                  << 1e3 * seconds << " ms  infected " << population.getInfectedCount()
+                  << verdict(population.getInfectedCount() == count, " (exact)", " (EXPECTED EXACT)")
+                  << "  with replacement ~" << std::setprecision(0) << shortfall << " fewer" << std::endl;
+    }
+    const int extraCounts[] = {size / 100, size / 2};
+    for (int extra : extraCounts) {
+        Clock::time_point start = Clock::now();
+        population.infectRandomPeople(extra);
+        double seconds = secondsSince(start);
+        std::cout << "+" << extra << " on a seeded population ("
+                  << (4LL * extra <= population.getSusceptibleCount() + extra ? "rejection" : "selection sampling")
+                  << ") " << std::setprecision(2) << 1e3 * seconds << " ms  infected "
+                  << population.getInfectedCount() << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Table-driven compartment kernels (SEIRS) and the agent day loop for SIR, SEIR and SEIRS
+ */
+void benchCompartments() {
+    const std::size_t count = scaled<std::size_t>(64u * 1024u * 1024u + 13u, 1024u * 1024u + 13u);
+    const int repetitions = scaled(20, 1);
+    const TransitionTable seirs = CompartmentModel::seirs(3, 5, 30).compile();
+    std::vector<std::uint8_t> baseStates(count), baseDays(count);
+    std::mt19937 gen(12345);
+    for (std::size_t i = 0; i < count; ++i) {
+        baseStates[i] = static_cast<std::uint8_t>(gen() % 4);
+        baseDays[i] = seirs.timed[baseStates[i]] ? static_cast<std::uint8_t>(1 + gen() % seirs.entryDays[baseStates[i]]) : 0;
+    }
+    std::cout << "--- Compartment kernels (SEIRS, " << count << " agents) ---" << std::endl;
+
+    const KernelIsa isas[] = {KernelIsa::Scalar, KernelIsa::AVX2, KernelIsa::AVX512};
+    std::vector<std::uint8_t> referenceStates, referenceDays;
+    CompartmentCounts referenceCounts = {{0}};
+    for (KernelIsa requested : isas) {
+        KernelIsa isa = setKernelIsa(requested);
+        if (isa != requested) {
+            continue;
+        }
+        std::vector<std::uint8_t> states = baseStates;
+        std::vector<std::uint8_t> days = baseDays;
+        CompartmentCounts counts = {{0}};
+        Clock::time_point start = Clock::now();
+        for (int r = 0; r < repetitions; ++r) {
+            counts = progressAndCountCompartments(seirs, states.data(), days.data(), count);
+        }
+        double seconds = secondsSince(start);
+        bool consistent = true;
+        if (isa == KernelIsa::Scalar) {
+            referenceStates = states;
+            referenceDays = days;
+            referenceCounts = counts;
+        } else {
+            consistent = states == referenceStates && days == referenceDays &&
+                         std::equal(counts.counts, counts.counts + MAX_COMPARTMENTS, referenceCounts.counts);
+        }
+        std::cout << std::left << std::setw(10) << kernelIsaName(isa) << std::right << std::fixed
+                  << std::setprecision(2) << " progress " << std::setw(7)
+                  << 4.0 * count * repetitions / seconds / 1e9 << " GB/s   "
+                  << verdict(consistent, "matches scalar", "MISMATCH") << std::endl;
+    }
+    setKernelIsa(detectKernelIsa());
+
+    // The SIR table run through the generic kernel must agree with the SIR kernel it dispatches to
+    std::vector<std::uint8_t> sirStates, sirDays;
+    makeAgents(count, sirStates, sirDays);
+    std::vector<std::uint8_t> genericStates = sirStates, genericDays = sirDays;
+    TransitionTable sir = CompartmentModel::sir(5).compile();
+    sir.sirLayout = false;
+    CompartmentCounts generic = progressAndCountCompartments(sir, genericStates.data(), genericDays.data(), count);
+    StateCounts dedicated = progressAndCountStates(sirStates.data(), sirDays.data(), count);
+    bool sirMatches = genericStates == sirStates && genericDays == sirDays &&
+                      generic.counts[0] == dedicated.susceptible && generic.counts[1] == dedicated.infected &&
+                      generic.counts[2] == dedicated.recovered;
+    std::cout << "SIR table on the generic kernel " << verdict(sirMatches, "matches", "DIFFERS FROM")
+              << " the SIR kernel" << std::endl;
+
+    const int size = scaled(10000000, 100000);
+    const int days = 30;
+    std::cout << "Day loop (N=" << size << ", 1% seeded, " << days << " days):" << std::endl;
+    const CompartmentModel models[] = {CompartmentModel::sir(5), CompartmentModel::seir(3, 5),
+                                       CompartmentModel::seirs(3, 5, 30)};
+    for (const CompartmentModel& model : models) {
+        Population population(size);
+        population.setInfectionProbability(0.05f);
+        population.setContactsPerDay(6);
+        population.setCompartmentModel(model);
+        population.setSeed(21);
+        population.infectRandomPeople(size / 100);
+        Clock::time_point start = Clock::now();
+        for (int d = 0; d < days; ++d) {
+            population.simulateOneDay();
+        }
+        double seconds = secondsSince(start);
+        std::cout << "  " << std::left << std::setw(6) << model.getName() << std::right << std::fixed
+                  << std::setprecision(1) << 1e3 * seconds / days << " ms/day  S " << population.getSusceptibleCount()
+                  << "  E " << population.getExposedCount() << "  I " << population.getInfectedCount() << "  R "
+                  << population.getRecoveredCount() << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Vaccination campaign days (O(doses) batches) against the day loop's pass over all agents
+ */
+void benchVaccination() {
+    const int size = scaled(100000000, 1000000);
+    const int days = 5;
+    std::cout << "--- Vaccination (agent engine, N=" << size << ", random priority order) ---" << std::endl;
+    Clock::time_point start = Clock::now();
+    VaccinationCampaign campaign = VaccinationCampaign::randomOrder(size, 99, 1);
+    std::cout << "priority queue built in " << std::fixed << std::setprecision(2) << secondsSince(start) << " s"
+              << std::endl;
+
+    Population population(size);
+    population.setInfectionDuration(5);
+    const int rates[] = {size / 1000, size / 100, size / 10};
+    for (int rate : rates) {
+        population.reset(1);
+        campaign.reset();
+        campaign.setDosesPerDay(rate);
+        double applySeconds = 0.0;
+        double daySeconds = 0.0;
+        for (int d = 0; d < days; ++d) {
+            start = Clock::now();
+            campaign.apply(population);
+            applySeconds += secondsSince(start);
+            start = Clock::now();
+            population.simulateOneDay();
+            daySeconds += secondsSince(start);
+        }
+        std::cout << std::setw(9) << rate << " doses/day: " << std::setprecision(2) << std::setw(7)
+                  << 1e3 * applySeconds / days << " ms/day (" << std::setprecision(1)
+                  << rate * days / applySeconds / 1e6 << " M doses/s), day loop " << std::setprecision(2)
+                  << 1e3 * daySeconds / days << " ms/day, vaccinated " << campaign.getVaccinatedCount()
+                  << verdict(campaign.getVaccinatedCount() == static_cast<std::int64_t>(rate) * days, " (exact)",
+                             " (MISMATCH)")
+                  << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Age-structured day loop (16 groups, assortative matrix) against homogeneous mixing
+ */
+void benchAgeStructure() {
+    const int size = 10000000;
+    const int groups = 16;
+    const int days = 30;
+    const double contactsPerDay = 6.0;
+    // Assortative mixing: contacts fall off with the age gap, rows rescaled to contactsPerDay
+    std::vector<double> rates(static_cast<std::size_t>(groups) * groups);
+    for (int g = 0; g < groups; ++g) {
+        double total = 0.0;
+        for (int h = 0; h < groups; ++h) {
+            rates[g * groups + h] = std::exp(-std::abs(g - h) / 2.0);
+            total += rates[g * groups + h];
+        }
+        for (int h = 0; h < groups; ++h) {
+            rates[g * groups + h] *= contactsPerDay / total;
+        }
+    }
+    auto matrix = std::make_shared<ContactMatrix>(groups, rates);
+    // Ages interleaved by ID, so grouping has to relabel every agent
+    std::vector<std::uint8_t> agentGroups(size);
+    for (int i = 0; i < size; ++i) {
+        agentGroups[i] = static_cast<std::uint8_t>(splitmix64(static_cast<std::uint64_t>(i)) % groups);
+    }
+    std::cout << "--- Age structure (N=" << size << ", " << groups << " groups, " << contactsPerDay
+              << " contacts/day, 1% seeded, " << days << " days) ---" << std::endl;
+
+    for (int mode = 0; mode < 2; ++mode) {
+        Population population(size);
+        population.setInfectionProbability(0.05f);
+        population.setContactsPerDay(static_cast<int>(contactsPerDay));
+        population.setInfectionDuration(5);
+        double setupSeconds = 0.0;
+        if (mode == 1) {
+            Clock::time_point start = Clock::now();
+            population.setAgeStructure(matrix, agentGroups);
+            setupSeconds = secondsSince(start);
+        }
+        population.setSeed(21);
+        population.infectRandomPeople(size / 100);
+        std::int64_t contacts = 0;
+        Clock::time_point start = Clock::now();
+        for (int d = 0; d < days; ++d) {
+            contacts += static_cast<std::int64_t>(population.getInfectedCount()) * static_cast<std::int64_t>(contactsPerDay);
+            population.simulateOneDay();
+        }
+        double seconds = secondsSince(start);
+        std::cout << (mode == 1 ? "age matrix  " : "homogeneous ") << std::fixed << std::setprecision(1)
+                  << 1e3 * seconds / days << " ms/day  " << std::setprecision(1) << 1e9 * seconds / contacts
+                  << " ns/contact  attack " << std::setprecision(3)
+                  << 1.0 - static_cast<double>(population.getSusceptibleCount()) / size;
+        if (mode == 1) {
+            std::vector<int> susceptible;
+            population.getAgeGroupCounts(HealthState::Susceptible, susceptible);
+            std::cout << "  (grouping " << std::setprecision(0) << 1e3 * setupSeconds << " ms; S youngest "
+                      << susceptible.front() << ", oldest " << susceptible.back() << ")";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Day loop with gamma-distributed per-agent infectiousness and susceptibility
+ */
+void benchHeterogeneity() {
+    const int size = 10000000;
+    const int days = 30;
+    const int contactsPerDay = 6;
+    std::cout << "--- Heterogeneous rates (N=" << size << ", " << contactsPerDay
+              << " contacts/day, 1% seeded, " << days << " days) ---" << std::endl;
+
+    const char* labels[] = {"equal rates          ", "infectiousness k=0.2 ", "+ susceptibility k=1 "};
+    for (int mode = 0; mode < 3; ++mode) {
+        Population population(size);
+        population.setInfectionProbability(0.05f);
+        population.setContactsPerDay(contactsPerDay);
+        population.setInfectionDuration(5);
+        Clock::time_point start = Clock::now();
+        std::size_t bytesPerAgent = 0;
+        if (mode >= 1) {
+            population.setInfectiousness(gammaRates(size, 0.2, 31));
+            bytesPerAgent += 1;
+        }
+        if (mode >= 2) {
+            population.setSusceptibility(gammaRates(size, 1.0, 32));
+            bytesPerAgent += 1 + 8;
+        }
+        double setupSeconds = secondsSince(start);
+        population.setSeed(21);
+        population.infectRandomPeople(size / 100);
+        std::int64_t infectedDays = 0;
+        start = Clock::now();
+        for (int d = 0; d < days; ++d) {
+            infectedDays += population.getInfectedCount();
+            population.simulateOneDay();
+        }
+        double seconds = secondsSince(start);
+        std::cout << labels[mode] << std::fixed << std::setprecision(1) << 1e3 * seconds / days << " ms/day  "
+                  << 1e9 * seconds / (infectedDays * contactsPerDay) << " ns/contact  attack " << std::setprecision(3)
+                  << 1.0 - static_cast<double>(population.getSusceptibleCount()) / size << "  (+" << bytesPerAgent
+                  << " B/agent, setup " << std::setprecision(0) << 1e3 * setupSeconds << " ms)" << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Alias-table build, incremental update and draws against std::discrete_distribution
+ */
+void benchAliasTable() {
+    const int threads = resolveThreadCount(0);
+    const int draws = 10000000;
+    auto weight = [](std::size_t i) { return 1.0 + static_cast<double>(splitmix64(i) % 1000) / 10.0; };
+    std::cout << "--- Alias table vs std::discrete_distribution (" << draws / 1000000 << "M draws, "
+              << threads << " threads) ---" << std::endl;
+
+    const std::size_t sizes[] = {1000, 1000000, 10000000, 100000000};
+    for (std::size_t size : sizes) {
+        AliasTable table;
+        Clock::time_point start = Clock::now();
+        table.build(size, weight, 1);
+        double serialBuild = secondsSince(start);
+        start = Clock::now();
+        table.build(size, weight, threads);
+        double parallelBuild = secondsSince(start);
+
+        std::mt19937_64 rng(5);
+        std::uint64_t checksum = 0;
+        start = Clock::now();
+        for (int d = 0; d < draws; ++d) {
+            checksum += table.sample(rng());
+        }
+        double aliasDraw = secondsSince(start);
+        std::cout << "N=" << std::setw(9) << size << "  alias: build " << std::fixed << std::setprecision(1)
+                  << 1e3 * serialBuild << " ms (" << 1e3 * parallelBuild << " ms on " << threads
+                  << " threads), draw " << std::setprecision(1) << 1e9 * aliasDraw / draws << " ns";
+
+        // The cumulative table of discrete_distribution needs 16 bytes per weight
+        if (size <= 10000000) {
+            std::vector<double> weights(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                weights[i] = weight(i);
+            }
+            start = Clock::now();
+            std::discrete_distribution<std::uint32_t> discrete(weights.begin(), weights.end());
+            double discreteBuild = secondsSince(start);
+            start = Clock::now();
+            for (int d = 0; d < draws; ++d) {
+                checksum += discrete(rng);
+            }
+            double discreteDraw = secondsSince(start);
+            std::cout << "  |  discrete: build " << std::setprecision(1) << 1e3 * discreteBuild << " ms, draw "
+                      << 1e9 * discreteDraw / draws << " ns";
+        }
+        std::cout << "  (checksum " << checksum % 1000 << ")" << std::endl;
+
+        if (size == 100000000) {
+            // A day's batch of weight changes: only the dirty blocks are rebuilt
+            const std::size_t batches[] = {1000, 100000, 1000000};
+            for (std::size_t batch : batches) {
+                std::vector<std::uint32_t> changed(batch);
+                for (std::size_t k = 0; k < batch; ++k) {
+                    changed[k] = static_cast<std::uint32_t>(boundedRandom(splitmix64(k + 1), size));
+                }
+                start = Clock::now();
+                table.update(changed.data(), changed.size(), [&](std::size_t i) { return weight(i) * 0.5; }, threads);
+                std::cout << "  update " << std::setw(7) << batch << " scattered weights: " << std::setprecision(1)
+                          << 1e3 * secondsSince(start) << " ms (full build " << 1e3 * parallelBuild << " ms)"
+                          << std::endl;
+            }
+        }
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Largest normalized rank error of a sketch over the percentiles 1..99 of exact sorted data
+ */
+double maxRankError(const QuantileSketch& sketch, const std::vector<double>& sorted) {
+    std::vector<double> qs;
+    for (int p = 1; p < 100; ++p) {
+        qs.push_back(p / 100.0);
+    }
+    const std::vector<double> estimates = sketch.quantiles(qs);
+    double worst = 0.0;
+    for (std::size_t j = 0; j < qs.size(); ++j) {
+        // Any rank the estimate's value occupies in the exact data counts as a hit
+        const double low = static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), estimates[j]) -
+                                               sorted.begin()) / sorted.size();
+        const double high = static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), estimates[j]) -
+                                                sorted.begin()) / sorted.size();
+        worst = std::max(worst, std::max(low - qs[j], qs[j] - high));
+    }
+    return worst;
+}
+
+/**
+ * @brief KLL sketch accuracy (single stream, lock-free merged threads) and ensemble quantiles
+ */
+void benchQuantiles() {
+    const int values = scaled(1000000, 100000);
+    const int trials = scaled(20, 4);
+    const int parts = 8;
+    const double bound = QuantileSketch::rankErrorBound(QuantileSketch::DEFAULT_K);
+    std::cout << "--- Quantile sketches (k=" << QuantileSketch::DEFAULT_K << ", " << values
+              << " heavy-tailed values, " << trials << " trials, error bound " << 100.0 * bound << "%) ---"
+              << std::endl;
+    double worstSingle = 0.0;
+    double worstMerged = 0.0;
+    double meanSingle = 0.0;
+    double addSeconds = 0.0;
+    std::size_t retained = 0;
+    bool countsExact = true;
+    for (int trial = 0; trial < trials; ++trial) {
+        std::mt19937_64 rng(static_cast<std::uint64_t>(trial) + 1);
+        std::lognormal_distribution<double> lognormal(0.0, 1.5);
+        std::vector<double> data(values);
+        for (double& value : data) {
+            value = lognormal(rng);
+        }
+
+        QuantileSketch single(QuantileSketch::DEFAULT_K, static_cast<std::uint64_t>(trial));
+        Clock::time_point start = Clock::now();
+        for (double value : data) {
+            single.add(value);
+        }
+        addSeconds += secondsSince(start);
+        retained = single.getRetained();
+
+        // Each part fills its own sketch and merges through the lock-free slot
+        MergeSlot<QuantileSketch> slot;
+        parallelFor(data.size(), parts, [&](std::size_t begin, std::size_t end, int part) {
+            std::unique_ptr<QuantileSketch> sketch(
+                new QuantileSketch(QuantileSketch::DEFAULT_K, streamSeed(static_cast<std::uint64_t>(trial), part)));
+            for (std::size_t i = begin; i < end; ++i) {
+                sketch->add(data[i]);
+            }
+            slot.publish(std::move(sketch));
+        });
+        std::unique_ptr<QuantileSketch> merged = slot.take();
+
+        std::sort(data.begin(), data.end());
+        const double singleError = maxRankError(single, data);
+        worstSingle = std::max(worstSingle, singleError);
+        meanSingle += singleError / trials;
+        worstMerged = std::max(worstMerged, maxRankError(*merged, data));
+        countsExact = countsExact && merged->getCount() == static_cast<std::uint64_t>(values);
+    }
+    std::cout << std::fixed << std::setprecision(2) << "max rank error over percentiles 1..99: single stream "
+              << 100.0 * worstSingle << "% " << verdict(worstSingle <= bound, "(within bound", "(OVER BOUND")
+              << ", mean " << 100.0 * meanSingle << "%), " << parts << " merged threads " << 100.0 * worstMerged
+              << "% " << verdict(worstMerged <= bound, "(within bound)", "(OVER BOUND)") << ", merged count "
+              << verdict(countsExact, "exact", "WRONG") << "  (add " << std::setprecision(1)
+              << 1e9 * addSeconds / (static_cast<double>(trials) * values) << " ns/value, " << retained
+              << " values retained)" << std::endl;
+
+    // Ensemble: per-day 5/50/95% of I against exact quantiles of stored trajectories
+    SimulationConfig config(1000, 5, 90, 0.06f, 6, 5);
+    config.seed = 17;
+    const int replicates = scaled(10000, 1000);
+    Clock::time_point start = Clock::now();
+    DailyQuantiles quantiles = SIRSimulation::runEnsemble(config, replicates);
+    const double ensembleSeconds = secondsSince(start);
+    const std::size_t trajectoryBytes =
+        static_cast<std::size_t>(replicates) * (config.simulationDays + 1) * DAILY_SERIES_COUNT * sizeof(int);
+    std::cout << "ensemble N=" << config.populationSize << ", " << replicates << " replicates x "
+              << config.simulationDays + 1 << " days: " << std::setprecision(0) << replicates / ensembleSeconds
+              << " runs/s, sketches " << std::setprecision(1) << quantiles.getRetained() * sizeof(double) / 1e6
+              << " MB vs " << trajectoryBytes / 1e6 << " MB of stored trajectories" << std::endl;
+
+    // Same replicates again, storing I to get the exact per-day quantiles
+    const int exactReplicates = scaled(2000, 500);
+    start = Clock::now();
+    DailyQuantiles check = SIRSimulation::runEnsemble(config, exactReplicates, 1);
+    const double sketchedSeconds = secondsSince(start);
+    std::vector<std::vector<double>> infected(config.simulationDays + 1);
+    SimulationConfig single = config;
+    single.threads = 1;
+    SIRSimulation simulation(single);
+    start = Clock::now();
+    for (int r = 0; r < exactReplicates; ++r) {
+        const unsigned int seed = static_cast<unsigned int>(streamSeed(config.seed, 4 + r));
+        simulation.reset(seed != 0 ? seed : 1u);
+        simulation.runReplicate();
+    }
+    const double plainSeconds = secondsSince(start);
+    std::cout << "one thread: " << std::setprecision(0) << exactReplicates / plainSeconds << " runs/s without sketches, "
+              << exactReplicates / sketchedSeconds << " runs/s with" << std::endl;
+    for (int r = 0; r < exactReplicates; ++r) {
+        const unsigned int seed = static_cast<unsigned int>(streamSeed(config.seed, 4 + r));
+        simulation.reset(seed != 0 ? seed : 1u);
+        DailyQuantiles one(config.simulationDays, QuantileSketch::DEFAULT_K);
+        simulation.setDailyQuantiles(&one);
+        simulation.runReplicate();
+        for (int day = 0; day <= config.simulationDays; ++day) {
+            infected[day].push_back(one.quantile(DailySeries::Infected, day, 0.5));
+        }
+    }
+    double worst = 0.0;
+    const double qs[] = {0.05, 0.5, 0.95};
+    for (int day = 0; day <= config.simulationDays; ++day) {
+        std::vector<double>& exact = infected[day];
+        std::sort(exact.begin(), exact.end());
+        for (double q : qs) {
+            const double estimate = check.quantile(DailySeries::Infected, day, q);
+            const double low = static_cast<double>(std::lower_bound(exact.begin(), exact.end(), estimate) -
+                                                   exact.begin()) / exact.size();
+            const double high = static_cast<double>(std::upper_bound(exact.begin(), exact.end(), estimate) -
+                                                    exact.begin()) / exact.size();
+            worst = std::max(worst, std::max(low - q, q - high));
+        }
+    }
+    std::cout << "I on day 10/20/30 (5%/50%/95%):";
+    for (int day = 10; day <= 30; day += 10) {
+        std::cout << "  " << std::setprecision(0) << quantiles.quantile(DailySeries::Infected, day, 0.05) << "/"
+                  << quantiles.quantile(DailySeries::Infected, day, 0.5) << "/"
+                  << quantiles.quantile(DailySeries::Infected, day, 0.95);
+    }
+    std::cout << std::endl << "max rank error of the 5/50/95% of I over " << config.simulationDays + 1
+              << " days (" << exactReplicates << " replicates vs exact): " << std::setprecision(2) << 100.0 * worst
+              << "% " << verdict(worst <= bound, "(within bound)", "(OVER BOUND)") << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Running mean and variance of a sample
+ */
+struct SampleMoments {
+    double sum;
+    double sumSquares;
+    int count;
+
+    SampleMoments() : sum(0.0), sumSquares(0.0), count(0) {}
+    void add(double value) {
+        sum += value;
+        sumSquares += value * value;
+        count++;
+    }
+    double mean() const { return sum / count; }
+    double variance() const { return (sumSquares - sum * sum / count) / (count - 1); }
+};
+
+/**
+ * @brief Difference of two sample means in standard errors
+ */
+double meanDifferenceZ(const SampleMoments& a, const SampleMoments& b) {
+    const double error = std::sqrt(a.variance() / a.count + b.variance() / b.count);
+    return error > 0.0 ? (a.mean() - b.mean()) / error : 0.0;
+}
+
+/**
+ * @brief Many tiny runs: the lane-batched engine vs one agent engine reset per replicate
+ */
+void benchBatch() {
+    const int agentRuns = scaled(5000, 200);
+    const std::size_t batchRuns = scaled<std::size_t>(50000, 2000);
+    const std::size_t checkRuns = scaled<std::size_t>(2000, 500);
+    std::cout << "--- Batched small populations (N=1000, " << BatchPopulation::LANES << " lanes, one thread; "
+              << agentRuns << " agent runs vs " << batchRuns << " batched runs) ---" << std::endl;
+    // The default configuration (R0 = 15) and a slower epidemic (R0 = 1.8) with some fade-outs
+    const float probabilities[] = {0.5f, 0.06f};
+    for (float probability : probabilities) {
+        SimulationConfig config;
+        config.infectionProbability = probability;
+        config.seed = 17;
+        config.threads = 1;
+
+        SampleMoments agentAttack, agentPeak, agentDays;
+        SIRSimulation simulation(config);
+        Clock::time_point start = Clock::now();
+        for (int r = 0; r < agentRuns; ++r) {
+            simulation.reset(static_cast<unsigned int>(r + 1));
+            const int days = simulation.runReplicate();
+            const EpidemicModel& model = simulation.getModel();
+            agentAttack.add(static_cast<double>(model.getPopulationSize() - model.getSusceptibleCount()) /
+                            model.getPopulationSize());
+            agentPeak.add(simulation.getStatistics().getPeakInfected());
+            agentDays.add(days);
+        }
+        const double agentSeconds = secondsSince(start);
+
+        start = Clock::now();
+        const std::vector<RunOutcome> outcomes = SIRSimulation::runBatch(config, batchRuns, 1);
+        const double batchSeconds = secondsSince(start);
+        SampleMoments batchAttack, batchPeak, batchDays;
+        for (const RunOutcome& outcome : outcomes) {
+            batchAttack.add(static_cast<double>(config.populationSize - outcome.finalSusceptible) /
+                            config.populationSize);
+            batchPeak.add(outcome.peakInfected);
+            batchDays.add(outcome.days);
+        }
+
+        // Run r depends only on (seed, r): a shorter batch on more threads repeats the first runs
+        const std::vector<RunOutcome> threaded = SIRSimulation::runBatch(config, checkRuns, 4);
+        bool same = true;
+        for (std::size_t r = 0; r < checkRuns; ++r) {
+            same = same && threaded[r].finalSusceptible == outcomes[r].finalSusceptible &&
+                   threaded[r].peakDay == outcomes[r].peakDay && threaded[r].days == outcomes[r].days;
+        }
+
+        std::cout << "p=" << std::setprecision(2) << probability << std::fixed << std::setprecision(0)
+                  << "  agent " << agentRuns / agentSeconds << " runs/s  batched " << batchRuns / batchSeconds
+                  << " runs/s  speedup " << std::setprecision(1) << agentSeconds / agentRuns * batchRuns / batchSeconds
+                  << "x  " << verdict(same, "same runs on 4 threads", "RUNS DIFFER ON 4 THREADS") << std::endl;
+        std::cout << "      attack rate " << std::setprecision(3) << agentAttack.mean() << " vs "
+                  << batchAttack.mean() << " (z " << std::setprecision(1) << meanDifferenceZ(agentAttack, batchAttack)
+                  << ")  peak " << agentPeak.mean() << " vs " << batchPeak.mean() << " (z "
+                  << meanDifferenceZ(agentPeak, batchPeak) << ")  days " << agentDays.mean() << " vs "
+                  << batchDays.mean() << " (z " << meanDifferenceZ(agentDays, batchDays) << ")"
+                  << std::defaultfloat << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+struct BenchmarkSection {
+    const char* name;
+    void (*run)();
+    bool crossChecks;       ///< Has pass/fail cross-checks (run by `check`)
+};
+
+const BenchmarkSection sections[] = {
+    {"kernels", benchStateKernels, true},
+    {"gillespie", benchGillespie, false},
+    {"tauleap", benchTauLeap, false},
+    {"ode", benchOde, false},
+    {"hybrid", benchHybrid, false},
+    {"network", benchNetwork, false},
+    {"generators", benchGenerators, true},
+    {"reorder", benchReorder, false},
+    {"metapop", benchMetapopulation, true},
+    {"alloc", benchAllocations, true},
+    {"pages", benchPages, false},
+    {"startup", benchStartup, false},
+    {"replicates", benchReplicates, true},
+    {"seeding", benchSeeding, true},
+    {"compartments", benchCompartments, true},
+    {"vaccination", benchVaccination, true},
+    {"age", benchAgeStructure, false},
+    {"heterogeneity", benchHeterogeneity, false},
+    {"alias", benchAliasTable, false},
+    {"quantiles", benchQuantiles, true},
+    {"batch", benchBatch, true},
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    quickCheck = argc > 1 && std::strcmp(argv[1], "check") == 0;
+    bool ranAny = false;
+    for (const BenchmarkSection& section : sections) {
+        if (quickCheck ? !section.crossChecks : argc > 1 && std::strcmp(argv[1], section.name) != 0) {
+            continue;
+        }
+        section.run();
+        ranAny = true;
+    }
+    if (!ranAny) {
+        std::cerr << "Unknown benchmark section: " << argv[1] << std::endl;
+        return 1;
+    }
+    if (failedChecks > 0) {
+        std::cerr << failedChecks << " cross-check(s) FAILED" << std::endl;
+        return 1;
+    }
+    if (quickCheck) {
+        std::cout << "All cross-checks passed" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file CompartmentModel.cpp
+ * @brief Implementation of the compartment table and its compilation
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "CompartmentModel.h"
+#include <stdexcept>
+
+CompartmentModel::CompartmentModel(const std::vector<Compartment>& table, int target)
+    : compartments(table), infectionTarget(target), vaccinationTarget(-1) {
+    validate();
+    for (HealthState role : {HealthState::Vaccinated, HealthState::Recovered}) {
+        for (int c = 0; c < getCompartmentCount() && vaccinationTarget < 0; ++c) {
+            if (compartments[c].role == role) {
+                vaccinationTarget = c;
+            }
+        }
+    }
+}
+
+void CompartmentModel::validate() const {
+    const int count = getCompartmentCount();
+    if (count < 1 || count > MAX_COMPARTMENTS) {
+        throw std::invalid_argument("Compartment table must have 1 to 16 rows");
+    }
+    if (compartments[0].role != HealthState::Susceptible) {
+        throw std::invalid_argument("Compartment 0 must be the susceptible compartment");
+    }
+    for (int c = 0; c < count; ++c) {
+        const Compartment& row = compartments[c];
+        if (c > 0 && row.role == HealthState::Susceptible) {
+            throw std::invalid_argument("Only compartment 0 may be susceptible");
+        }
+        if (row.duration < 0 || row.duration > MAX_INFECTION_DURATION) {
+            throw std::invalid_argument("Compartment duration must be between 0 and 255 days");
+        }
+        if (row.role == HealthState::Susceptible && row.duration != 0) {
+            throw std::invalid_argument("The susceptible compartment cannot be timed");
+        }
+        if (row.next < -1 || row.next >= count || row.next == c) {
+            throw std::invalid_argument("Invalid successor of compartment " + row.name);
+        }
+        if (row.duration > 0 && row.next < 0) {
+            throw std::invalid_argument("Timed compartment " + row.name + " needs a successor");
+        }
+    }
+    if (infectionTarget < 1 || infectionTarget >= count) {
+        throw std::invalid_argument("Infection must lead into a non-susceptible compartment");
+    }
+}
+
+CompartmentModel CompartmentModel::sir(int infectiousDays) {
+    return CompartmentModel({{"S", HealthState::Susceptible, 0, -1},
+                             {"I", HealthState::Infected, infectiousDays, 2},
+                             {"R", HealthState::Recovered, 0, -1}},
+                            1);
+}
+
+CompartmentModel CompartmentModel::sirs(int infectiousDays, int immunityDays) {
+    return CompartmentModel({{"S", HealthState::Susceptible, 0, -1},
+                             {"I", HealthState::Infected, infectiousDays, 2},
+                             {"R", HealthState::Recovered, immunityDays, 0}},
+                            1);
+}
+
+CompartmentModel CompartmentModel::seir(int latentDays, int infectiousDays) {
+    return CompartmentModel({{"S", HealthState::Susceptible, 0, -1},
+                             {"E", HealthState::Exposed, latentDays, 2},
+                             {"I", HealthState::Infected, infectiousDays, 3},
+                             {"R", HealthState::Recovered, 0, -1}},
+                            1);
+}
+
+CompartmentModel CompartmentModel::seirs(int latentDays, int infectiousDays, int immunityDays) {
+    return CompartmentModel({{"S", HealthState::Susceptible, 0, -1},
+                             {"E", HealthState::Exposed, latentDays, 2},
+                             {"I", HealthState::Infected, infectiousDays, 3},
+                             {"R", HealthState::Recovered, immunityDays, 0}},
+                            1);
+}
+
+CompartmentModel CompartmentModel::withVaccinated(int waningDays) const {
+    std::vector<Compartment> extended = compartments;
+    extended.push_back({"V", HealthState::Vaccinated, waningDays, waningDays > 0 ? 0 : -1});
+    return CompartmentModel(extended, infectionTarget);
+}
+
+void CompartmentModel::setRoleDuration(HealthState role, int days) {
+    std::vector<Compartment> updated = compartments;
+    for (Compartment& row : updated) {
+        if (row.role == role) {
+            row.duration = days;
+        }
+    }
+    *this = CompartmentModel(updated, infectionTarget);
+}
+
+int CompartmentModel::getRoleDuration(HealthState role) const {
+    for (const Compartment& row : compartments) {
+        if (row.role == role) {
+            return row.duration;
+        }
+    }
+    return 0;
+}
+
+bool CompartmentModel::isComplete() const {
+    for (const Compartment& row : compartments) {
+        if ((row.role == HealthState::Exposed || row.role == HealthState::Infected) && row.duration <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompartmentModel::isSir() const {
+    return getCompartmentCount() == 3 && infectionTarget == 1 && compartments[1].role == HealthState::Infected &&
+           compartments[1].next == 2 && compartments[2].role == HealthState::Recovered &&
+           compartments[2].duration == 0;
+}
+
+TransitionTable CompartmentModel::compile() const {
+    TransitionTable table;
+    table.compartments = static_cast<std::uint8_t>(getCompartmentCount());
+    for (int c = 0; c < MAX_COMPARTMENTS; ++c) {
+        bool timed = c < getCompartmentCount() && compartments[c].duration > 0;
+        table.timed[c] = timed ? 0xFF : 0;
+        table.next[c] = static_cast<std::uint8_t>(timed ? compartments[c].next : c);
+        table.entryDays[c] = static_cast<std::uint8_t>(c < getCompartmentCount() ? compartments[c].duration : 0);
+    }
+    table.sirLayout = isSir() && compartments[1].duration > 0;
+    return table;
+}
+
+std::string CompartmentModel::getName() const {
+    std::string name;
+    bool wanes = false;
+    for (const Compartment& row : compartments) {
+        name += row.name;
+        wanes = wanes || (row.duration > 0 && row.next == 0);
+    }
+    return wanes ? name + compartments[0].name : name;
+}
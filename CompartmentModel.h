@@ -0,0 +1,143 @@
+/**
+ * @file CompartmentModel.h
+ * @brief Table-driven description of the disease course (SIR, SEIR, SEIRS, ...)
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the CompartmentModel class which lists the compartments
+ * an agent moves through and compiles them into the TransitionTable consumed
+ * by the state kernels.
+ */
+
+#ifndef COMPARTMENT_MODEL_H
+#define COMPARTMENT_MODEL_H
+
+#include "Person.h"
+#include "StateKernels.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief One row of a compartment table
+ */
+struct Compartment {
+    std::string name;   ///< Short label used in output (e.g. "E")
+    HealthState role;   ///< S/E/I/R class the compartment is reported under (Infected = infectious)
+    int duration;       ///< Days spent in the compartment (0 = untimed: left only by infection, or never)
+    int next;           ///< Compartment entered after duration days (-1 if none)
+};
+
+/**
+ * @brief Compartments and timed transitions of the disease course
+ *
+ * Row c of the table is the compartment with state code c. Row 0 must be the
+ * only susceptible compartment, so a zero-filled state column is an
+ * all-susceptible population. Infection moves a susceptible agent into the
+ * infection target; every other transition is a countdown of `duration`
+ * days into `next`. For example SEIRS is
+ *
+ *     {{"S", Susceptible, 0, -1}, {"E", Exposed, 3, 2}, {"I", Infected, 5, 3}, {"R", Recovered, 90, 0}}
+ *
+ * with infection target 1. Exposed and infectious compartments may carry a
+ * zero duration while parameters are still being set; isComplete() reports
+ * whether the table can be simulated.
+ *
+ * Vaccination moves a susceptible agent into the first compartment with the
+ * Vaccinated role, or the first Recovered one when there is none.
+ */
+class CompartmentModel {
+private:
+    std::vector<Compartment> compartments;   ///< Table rows, indexed by state code
+    int infectionTarget;                     ///< Compartment entered on infection
+    int vaccinationTarget;                   ///< Compartment entered on vaccination (-1 if none)
+
+    /**
+     * @brief Checks the table invariants
+     *
+     * @throws std::invalid_argument on any violation
+     */
+    void validate() const;
+
+public:
+    /**
+     * @brief Builds a model from a compartment table
+     *
+     * @param table Rows indexed by state code (1..MAX_COMPARTMENTS rows)
+     * @param target Compartment entered on infection
+     * @throws std::invalid_argument if row 0 is not the only susceptible
+     *         compartment, a row is susceptible but timed, a duration is outside
+     *         0..MAX_INFECTION_DURATION, a timed row has no valid successor or
+     *         the target is out of range or susceptible
+     */
+    CompartmentModel(const std::vector<Compartment>& table, int target);
+
+    /**
+     * @brief S -> I -> R
+     */
+    static CompartmentModel sir(int infectiousDays);
+
+    /**
+     * @brief S -> I -> R -> S with immunity waning after immunityDays
+     */
+    static CompartmentModel sirs(int infectiousDays, int immunityDays);
+
+    /**
+     * @brief S -> E -> I -> R
+     */
+    static CompartmentModel seir(int latentDays, int infectiousDays);
+
+    /**
+     * @brief S -> E -> I -> R -> S with immunity waning after immunityDays
+     */
+    static CompartmentModel seirs(int latentDays, int infectiousDays, int immunityDays);
+
+    /**
+     * @brief Copy of the model with a separate vaccinated compartment "V"
+     *
+     * @param waningDays Days until vaccinated individuals are susceptible again (0 = lifelong)
+     * @throws std::invalid_argument if the table is full or waningDays is out of range
+     */
+    CompartmentModel withVaccinated(int waningDays) const;
+
+    /**
+     * @brief Sets the duration of every compartment reported under a role
+     *
+     * @param role Reporting class (e.g. HealthState::Infected for the infectious period)
+     * @param days Duration in days (0..MAX_INFECTION_DURATION)
+     * @throws std::invalid_argument if days is out of range or a compartment
+     *         would become timed without a successor
+     */
+    void setRoleDuration(HealthState role, int days);
+
+    /**
+     * @brief Gets the duration of the first compartment reported under a role (0 if none)
+     */
+    int getRoleDuration(HealthState role) const;
+
+    /**
+     * @brief Checks that every exposed and infectious compartment has a positive duration
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Checks whether the table is plain S -> I -> R with lifelong immunity
+     */
+    bool isSir() const;
+
+    /**
+     * @brief Compiles the table into kernel lookup tables
+     */
+    TransitionTable compile() const;
+
+    /**
+     * @brief Gets a short name such as "SEIRS" (compartment names, plus "S" when immunity wanes)
+     */
+    std::string getName() const;
+
+    int getCompartmentCount() const { return static_cast<int>(compartments.size()); }
+    const Compartment& getCompartment(int code) const { return compartments[code]; }
+    int getInfectionTarget() const { return infectionTarget; }
+    int getVaccinationTarget() const { return vaccinationTarget; }
+};
+
+#endif // COMPARTMENT_MODEL_H
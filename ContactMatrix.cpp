@@ -0,0 +1,92 @@
+/**
+ * @file ContactMatrix.cpp
+ * @brief Implementation of the age-by-age contact matrix
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "ContactMatrix.h"
+#include "AliasTable.h"
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+ContactMatrix::ContactMatrix(int groupCount, const std::vector<double>& contactRates)
+    : groups(groupCount), rates(contactRates) {
+    if (groups < 1 || groups > MAX_AGE_GROUPS) {
+        throw std::invalid_argument("Contact matrix must have 1 to 256 age groups");
+    }
+    if (rates.size() != static_cast<std::size_t>(groups) * groups) {
+        throw std::invalid_argument("Contact matrix must have groups x groups rates");
+    }
+    rowTotals.assign(groups, 0.0);
+    acceptance.assign(rates.size(), UINT32_MAX);
+    aliases.resize(rates.size());
+    for (int g = 0; g < groups; ++g) {
+        for (int h = 0; h < groups; ++h) {
+            double rate = getRate(g, h);
+            if (!std::isfinite(rate) || rate < 0.0) {
+                throw std::invalid_argument("Contact rates must be finite and non-negative");
+            }
+            rowTotals[g] += rate;
+        }
+        buildAliasRow(g);
+    }
+}
+
+void ContactMatrix::buildAliasRow(int group) {
+    // Compact copy of a generic table: a row has at most 256 columns, so aliases fit one byte
+    const std::size_t row = static_cast<std::size_t>(group) * groups;
+    AliasTable table(std::vector<double>(rates.begin() + row, rates.begin() + row + groups));
+    for (int h = 0; h < groups; ++h) {
+        acceptance[row + h] = table.getAcceptance(h);
+        aliases[row + h] = static_cast<std::uint8_t>(table.getAlias(h));
+    }
+}
+
+ContactMatrix ContactMatrix::homogeneous(int groupCount, double contactsPerDay) {
+    if (groupCount < 1) {
+        throw std::invalid_argument("Contact matrix must have 1 to 256 age groups");
+    }
+    return ContactMatrix(groupCount, std::vector<double>(static_cast<std::size_t>(groupCount) * groupCount,
+                                                         contactsPerDay / groupCount));
+}
+
+ContactMatrix ContactMatrix::loadFile(const std::string& path) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        throw std::runtime_error("Cannot open contact matrix file: " + path);
+    }
+    std::vector<double> contactRates;
+    int columns = 0;
+    int rows = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        int entries = 0;
+        double rate = 0.0;
+        while (fields >> rate) {
+            contactRates.push_back(rate);
+            entries++;
+        }
+        if (!fields.eof() || (rows > 0 && entries != columns)) {
+            throw std::runtime_error("Malformed contact matrix row: " + line);
+        }
+        columns = entries;
+        rows++;
+    }
+    if (rows != columns) {
+        throw std::runtime_error("Contact matrix must be square: " + path);
+    }
+    try {
+        return ContactMatrix(rows, contactRates);
+    } catch (const std::invalid_argument& error) {
+        throw std::runtime_error(std::string(error.what()) + ": " + path);
+    }
+}
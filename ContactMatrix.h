@@ -0,0 +1,91 @@
+/**
+ * @file ContactMatrix.h
+ * @brief Age-by-age contact rates for age-structured mixing
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the ContactMatrix class which holds the mean number of
+ * daily contacts between age groups and the per-row sampling tables used to
+ * draw the age group of each contact.
+ */
+
+#ifndef CONTACT_MATRIX_H
+#define CONTACT_MATRIX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Largest number of age groups (group codes are stored in one byte per agent)
+const int MAX_AGE_GROUPS = 256;
+
+/**
+ * @brief Mean daily contacts made by a member of group g with members of group h
+ *
+ * Rates are directed: rate(g, h) is what an infectious member of g contacts,
+ * and is not required to balance rate(h, g) (as survey matrices usually do
+ * not). Each row is also compiled into an alias table (Vose's method), so
+ * drawing the target group of a contact is O(1): one 32-bit random word picks
+ * a column and decides between it and its alias.
+ */
+class ContactMatrix {
+private:
+    int groups;                         ///< Number of age groups
+    std::vector<double> rates;          ///< Row-major contacts per day (groups x groups)
+    std::vector<double> rowTotals;      ///< Contacts per day made by a member of each group
+    std::vector<std::uint32_t> acceptance;  ///< Row-major probability of keeping the drawn column, times 2^32
+    std::vector<std::uint8_t> aliases;  ///< Row-major group taken when the column is rejected
+
+    /**
+     * @brief Builds the alias table of one row
+     */
+    void buildAliasRow(int group);
+
+public:
+    /**
+     * @brief Builds a matrix from row-major rates
+     *
+     * @param groupCount Number of age groups (1..MAX_AGE_GROUPS)
+     * @param contactRates groupCount x groupCount non-negative contacts per day
+     * @throws std::invalid_argument if the size or a rate is invalid
+     */
+    ContactMatrix(int groupCount, const std::vector<double>& contactRates);
+
+    /**
+     * @brief Every group contacts every group alike (contactsPerDay in total, spread evenly)
+     */
+    static ContactMatrix homogeneous(int groupCount, double contactsPerDay);
+
+    /**
+     * @brief Loads a matrix from a text file
+     *
+     * One row per line with whitespace-separated rates; the number of rows is
+     * the number of groups and every row must have that many entries. Lines
+     * starting with '#' are comments.
+     *
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     */
+    static ContactMatrix loadFile(const std::string& path);
+
+    /**
+     * @brief Draws the target group of one contact of a member of group g
+     *
+     * bits * groups / 2^32 selects a column and the remainder is compared
+     * with its acceptance threshold, so one word drives both decisions.
+     *
+     * @param group Group of the contacting individual
+     * @param bits Uniform 32-bit random word
+     */
+    int sampleTargetGroup(int group, std::uint32_t bits) const {
+        const std::uint64_t scaled = static_cast<std::uint64_t>(bits) * static_cast<std::uint32_t>(groups);
+        const int column = static_cast<int>(scaled >> 32);
+        const std::size_t cell = static_cast<std::size_t>(group) * groups + column;
+        return static_cast<std::uint32_t>(scaled) < acceptance[cell] ? column : aliases[cell];
+    }
+
+    int getGroupCount() const { return groups; }
+    double getRate(int group, int target) const { return rates[static_cast<std::size_t>(group) * groups + target]; }
+    double getRowTotal(int group) const { return rowTotals[group]; }
+};
+
+#endif // CONTACT_MATRIX_H
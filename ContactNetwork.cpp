@@ -0,0 +1,194 @@
+/**
+ * @file ContactNetwork.cpp
+ * @brief Implementation of the CSR contact network and its mmap edge-list loader
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "ContactNetwork.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Read-only memory mapping of a whole file (RAII)
+ */
+class MappedFile {
+private:
+    const char* data;
+    std::size_t length;
+
+public:
+    explicit MappedFile(const std::string& path) : data(nullptr), length(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open edge list: " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat edge list: " + path);
+        }
+        length = static_cast<std::size_t>(info.st_size);
+        if (length > 0) {
+            void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map edge list: " + path);
+            }
+            ::madvise(mapping, length, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFile() {
+        if (data != nullptr) {
+            ::munmap(const_cast<char*>(data), length);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const { return data; }
+    std::size_t size() const { return length; }
+};
+
+bool isBinaryPath(const std::string& path) {
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == ',';
+}
+
+/**
+ * @brief Calls visit(u, v) for every edge of a text edge list
+ */
+template <typename Visitor>
+void forEachTextEdge(const char* p, const char* end, Visitor visit) {
+    while (p < end) {
+        while (p < end && (isBlank(*p) || *p == '\n')) {
+            ++p;
+        }
+        if (p == end) {
+            break;
+        }
+        if (*p == '#' || *p == '%') {
+            while (p < end && *p != '\n') {
+                ++p;
+            }
+            continue;
+        }
+        std::uint64_t ids[2];
+        for (int k = 0; k < 2; ++k) {
+            while (p < end && isBlank(*p)) {
+                ++p;
+            }
+            if (p == end || *p < '0' || *p > '9') {
+                throw std::runtime_error("Malformed edge list line");
+            }
+            std::uint64_t value = 0;
+            while (p < end && *p >= '0' && *p <= '9') {
+                value = value * 10 + static_cast<std::uint64_t>(*p - '0');
+                ++p;
+            }
+            if (value > UINT32_MAX) {
+                throw std::runtime_error("Edge list node index exceeds 32 bits");
+            }
+            ids[k] = value;
+        }
+        // Ignore anything else on the line (e.g. weights)
+        while (p < end && *p != '\n') {
+            ++p;
+        }
+        visit(static_cast<std::uint32_t>(ids[0]), static_cast<std::uint32_t>(ids[1]));
+    }
+}
+
+/**
+ * @brief Calls visit(u, v) for every edge of a binary uint32-pair edge list
+ */
+template <typename Visitor>
+void forEachBinaryEdge(const char* p, std::size_t length, Visitor visit) {
+    if (length % (2 * sizeof(std::uint32_t)) != 0) {
+        throw std::runtime_error("Binary edge list size is not a multiple of 8 bytes");
+    }
+    for (std::size_t offset = 0; offset < length; offset += 2 * sizeof(std::uint32_t)) {
+        std::uint32_t pair[2];
+        std::memcpy(pair, p + offset, sizeof(pair));
+        visit(pair[0], pair[1]);
+    }
+}
+
+template <typename Visitor>
+void forEachEdge(const MappedFile& file, bool binary, Visitor visit) {
+    if (binary) {
+        forEachBinaryEdge(file.begin(), file.size(), visit);
+    } else {
+        forEachTextEdge(file.begin(), file.begin() + file.size(), visit);
+    }
+}
+
+} // namespace
+
+ContactNetwork::ContactNetwork() : offsets(1, 0) {
+}
+
+ContactNetwork::ContactNetwork(std::vector<std::uint64_t>&& csrOffsets, std::vector<std::uint32_t>&& csrNeighbors)
+    : offsets(std::move(csrOffsets)), neighbors(std::move(csrNeighbors)) {
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != neighbors.size()) {
+        throw std::invalid_argument("CSR offsets do not match the neighbor array");
+    }
+    if (offsets.size() - 1 > UINT32_MAX) {
+        throw std::invalid_argument("Contact network exceeds 32-bit node indices");
+    }
+}
+
+ContactNetwork ContactNetwork::loadEdgeList(const std::string& path, std::uint32_t nodeCount) {
+    MappedFile file(path);
+    const bool binary = isBinaryPath(path);
+
+    // Pass 1: degrees (grown on demand when the node count is not given)
+    std::vector<std::uint64_t> degree(nodeCount, 0);
+    forEachEdge(file, binary, [&](std::uint32_t u, std::uint32_t v) {
+        if (u == v) {
+            return;
+        }
+        std::uint32_t largest = u > v ? u : v;
+        if (largest >= degree.size()) {
+            if (nodeCount != 0) {
+                throw std::runtime_error("Edge list node index exceeds the population size");
+            }
+            degree.resize(static_cast<std::size_t>(largest) + 1, 0);
+        }
+        degree[u]++;
+        degree[v]++;
+    });
+
+    std::vector<std::uint64_t> csrOffsets(degree.size() + 1, 0);
+    for (std::size_t i = 0; i < degree.size(); ++i) {
+        csrOffsets[i + 1] = csrOffsets[i] + degree[i];
+    }
+
+    // Pass 2: fill both directions, reusing the degree array as the write cursor
+    std::vector<std::uint32_t> csrNeighbors(csrOffsets.back());
+    std::copy(csrOffsets.begin(), csrOffsets.end() - 1, degree.begin());
+    forEachEdge(file, binary, [&](std::uint32_t u, std::uint32_t v) {
+        if (u == v) {
+            return;
+        }
+        csrNeighbors[degree[u]++] = v;
+        csrNeighbors[degree[v]++] = u;
+    });
+
+    return ContactNetwork(std::move(csrOffsets), std::move(csrNeighbors));
+}
@@ -0,0 +1,97 @@
+/**
+ * @file ContactNetwork.h
+ * @brief Compressed sparse row (CSR) storage for large contact networks
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the ContactNetwork class which stores an undirected
+ * contact graph as offsets + neighbor arrays and loads edge lists via mmap.
+ */
+
+#ifndef CONTACT_NETWORK_H
+#define CONTACT_NETWORK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Undirected contact network in CSR layout
+ *
+ * The neighbors of node i are neighbors[offsets[i] .. offsets[i + 1]).
+ * Every undirected edge is stored once in each direction.
+ *
+ * Memory usage:
+ * - 8 bytes per undirected edge (two 32-bit neighbor entries)
+ * - 8 bytes per node (one 64-bit offset)
+ *
+ * so a network of 10^8 edges over 10^7 nodes needs about 0.88 GB. Node indices
+ * are 32-bit (up to 4,294,967,295 nodes); offsets are 64-bit so the neighbor
+ * array may exceed 2^32 entries.
+ */
+class ContactNetwork {
+private:
+    std::vector<std::uint64_t> offsets;     ///< Start of each node's neighbor range (size nodes + 1)
+    std::vector<std::uint32_t> neighbors;   ///< Concatenated neighbor lists
+
+public:
+    /**
+     * @brief Creates an empty network with no nodes
+     */
+    ContactNetwork();
+
+    /**
+     * @brief Takes ownership of prebuilt CSR arrays
+     *
+     * @param csrOffsets Offsets array of size nodes + 1, starting at 0 and non-decreasing
+     * @param csrNeighbors Neighbor array of size csrOffsets.back()
+     * @throws std::invalid_argument if the arrays are inconsistent
+     */
+    ContactNetwork(std::vector<std::uint64_t>&& csrOffsets, std::vector<std::uint32_t>&& csrNeighbors);
+
+    /**
+     * @brief Loads an undirected edge list through a read-only memory mapping
+     *
+     * Two formats are supported:
+     * - Text (any extension except .bin): one "u v" pair per line, separated by
+     *   whitespace; lines starting with '#' or '%' are comments
+     * - Binary (.bin): consecutive little-endian uint32 pairs
+     *
+     * The file is scanned twice (degree count, then fill), so no intermediate
+     * edge list is held in memory. Self-loops are dropped; edge lists are
+     * assumed not to contain duplicate edges.
+     *
+     * @param path Edge list file
+     * @param nodeCount Number of nodes, or 0 to use the largest index + 1
+     * @return The loaded network
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     */
+    static ContactNetwork loadEdgeList(const std::string& path, std::uint32_t nodeCount = 0);
+
+    std::uint32_t getNodeCount() const {
+        return static_cast<std::uint32_t>(offsets.empty() ? 0 : offsets.size() - 1);
+    }
+    std::uint64_t getEdgeCount() const { return neighbors.size() / 2; }
+    std::uint32_t getDegree(std::uint32_t node) const {
+        return static_cast<std::uint32_t>(offsets[node + 1] - offsets[node]);
+    }
+
+    /**
+     * @brief Gets the first neighbor of a node (range end is neighborsEnd(node))
+     */
+    const std::uint32_t* neighborsBegin(std::uint32_t node) const { return neighbors.data() + offsets[node]; }
+    const std::uint32_t* neighborsEnd(std::uint32_t node) const { return neighbors.data() + offsets[node + 1]; }
+
+    const std::vector<std::uint64_t>& getOffsets() const { return offsets; }
+    const std::vector<std::uint32_t>& getNeighbors() const { return neighbors; }
+
+    /**
+     * @brief Gets the heap memory used by the CSR arrays in bytes
+     */
+    std::size_t getMemoryBytes() const {
+        return offsets.size() * sizeof(std::uint64_t) + neighbors.size() * sizeof(std::uint32_t);
+    }
+};
+
+#endif // CONTACT_NETWORK_H
@@ -0,0 +1,269 @@
+/**
+ * @file DistributedPopulation.cpp
+ * @brief Implementation of the MPI-partitioned agent population
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "DistributedPopulation.h"
+#include "Person.h"
+#include "StateKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+DistributedPopulation::DistributedPopulation(int populationSize, MPI_Comm communicator)
+    : comm(communicator), rank(0), rankCount(1), size(populationSize), day(0),
+      countSusceptible(populationSize), countInfected(0), countRecovered(0),
+      countImmunized(0), infectionProbability(0.0f), contactsPerDay(0.0), infectionDuration(0),
+      seed(0), exchangedAttempts(0) {
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &rankCount);
+    if (populationSize < rankCount) {
+        throw std::invalid_argument("Distributed population needs at least one individual per rank");
+    }
+
+    rankFirst.resize(rankCount + 1);
+    for (int r = 0; r <= rankCount; ++r) {
+        rankFirst[r] = static_cast<std::uint32_t>(static_cast<std::int64_t>(size) * r / rankCount);
+    }
+    const std::size_t localSize = rankFirst[rank + 1] - rankFirst[rank];
+    states.assign(localSize, static_cast<std::uint8_t>(HealthState::Susceptible));
+    daysLeft.assign(localSize, 0);
+    outgoing.resize(rankCount);
+    setSeed(0);
+}
+
+void DistributedPopulation::setSeed(unsigned int seedValue) {
+    seed = seedValue;
+    seedingRng.seed(streamSeed(seed, ~0ULL));
+}
+
+void DistributedPopulation::reset(unsigned int seedValue) {
+    std::fill(states.begin(), states.end(), static_cast<std::uint8_t>(HealthState::Susceptible));
+    std::fill(daysLeft.begin(), daysLeft.end(), 0);
+    day = 0;
+    countSusceptible = size;
+    countInfected = 0;
+    countRecovered = 0;
+    countImmunized = 0;
+    exchangedAttempts = 0;
+    setSeed(seedValue);
+}
+
+void DistributedPopulation::setInfectionProbability(float probability) {
+    infectionProbability = probability;
+}
+
+void DistributedPopulation::setContactsPerDay(double contacts) {
+    contactsPerDay = contacts;
+}
+
+void DistributedPopulation::setInfectionDuration(int days) {
+    if (days <= 0 || days > MAX_INFECTION_DURATION) {
+        throw std::invalid_argument("Infection duration must be between 1 and 255 days");
+    }
+    infectionDuration = days;
+}
+
+int DistributedPopulation::ownerOf(std::uint32_t id) const {
+    return static_cast<int>(std::upper_bound(rankFirst.begin() + 1, rankFirst.end(), id) - rankFirst.begin() - 1);
+}
+
+void DistributedPopulation::reduceCounts(std::int64_t susceptible, std::int64_t infected, std::int64_t recovered) {
+    std::int64_t local[3] = {susceptible, infected, recovered};
+    std::int64_t global[3];
+    MPI_Allreduce(local, global, 3, MPI_INT64_T, MPI_SUM, comm);
+    countSusceptible = static_cast<int>(global[0]);
+    countInfected = static_cast<int>(global[1]);
+    countRecovered = static_cast<int>(global[2]);
+}
+
+int DistributedPopulation::infectOwned(std::uint32_t id) {
+    if (id < rankFirst[rank] || id >= rankFirst[rank + 1]) {
+        return 0;
+    }
+    std::size_t local = id - rankFirst[rank];
+    if (states[local] != static_cast<std::uint8_t>(HealthState::Susceptible)) {
+        return 0;
+    }
+    states[local] = static_cast<std::uint8_t>(HealthState::Infected);
+    daysLeft[local] = static_cast<std::uint8_t>(infectionDuration);
+    return 1;
+}
+
+void DistributedPopulation::infectRandomPeople(int count) {
+    if (count < 0 || count > countSusceptible) {
+        throw std::invalid_argument("Cannot infect more people than are susceptible");
+    }
+    if (infectionDuration <= 0) {
+        throw std::invalid_argument("Infection duration must be positive");
+    }
+    std::unordered_set<std::uint32_t> drawn;
+    int infected = 0;
+    while (infected < count) {
+        int local = 0;
+        for (int i = infected; i < count; ++i) {
+            std::uint32_t id;
+            do {
+                id = static_cast<std::uint32_t>(boundedRandom(seedingRng(), static_cast<std::uint64_t>(size)));
+            } while (!drawn.insert(id).second);
+            local += infectOwned(id);
+        }
+        int round = 0;
+        MPI_Allreduce(&local, &round, 1, MPI_INT, MPI_SUM, comm);
+        infected += round;
+    }
+    countSusceptible -= count;
+    countInfected += count;
+}
+
+void DistributedPopulation::infectPeople(const std::vector<std::uint32_t>& ids) {
+    if (infectionDuration <= 0) {
+        throw std::invalid_argument("Infection duration must be positive");
+    }
+    // Validate the whole list first, so a bad ID leaves every rank untouched
+    auto invalid = std::find_if(ids.begin(), ids.end(), [this](std::uint32_t id) {
+        return id >= static_cast<std::uint32_t>(size);
+    });
+    if (invalid != ids.end()) {
+        throw std::out_of_range("Agent ID out of range: " + std::to_string(*invalid));
+    }
+    int local = 0;
+    for (std::uint32_t id : ids) {
+        local += infectOwned(id);
+    }
+    int infected = 0;
+    MPI_Allreduce(&local, &infected, 1, MPI_INT, MPI_SUM, comm);
+    countSusceptible -= infected;
+    countInfected += infected;
+}
+
+int DistributedPopulation::vaccinatePeople(const std::uint32_t* ids, std::size_t count) {
+    // Validate the whole batch first, so a bad ID leaves every rank untouched
+    const std::uint32_t* invalid = std::find_if(ids, ids + count, [this](std::uint32_t id) {
+        return id >= static_cast<std::uint32_t>(size);
+    });
+    if (invalid != ids + count) {
+        throw std::out_of_range("Agent ID out of range: " + std::to_string(*invalid));
+    }
+    const std::uint32_t first = rankFirst[rank];
+    const std::uint32_t last = rankFirst[rank + 1];
+    int local = 0;
+    for (std::size_t k = 0; k < count; ++k) {
+        if (ids[k] >= first && ids[k] < last &&
+            states[ids[k] - first] == static_cast<std::uint8_t>(HealthState::Susceptible)) {
+            states[ids[k] - first] = static_cast<std::uint8_t>(HealthState::Recovered);
+            local++;
+        }
+    }
+    int vaccinated = 0;
+    MPI_Allreduce(&local, &vaccinated, 1, MPI_INT, MPI_SUM, comm);
+    countSusceptible -= vaccinated;
+    countRecovered += vaccinated;
+    countImmunized += vaccinated;
+    return vaccinated;
+}
+
+void DistributedPopulation::infectRandomPerson() {
+    if (infectionDuration <= 0) {
+        throw std::invalid_argument("Infection duration must be positive");
+    }
+    std::uint32_t id = static_cast<std::uint32_t>(boundedRandom(seedingRng(), static_cast<std::uint64_t>(size)));
+    int owner = ownerOf(id);
+    int infected = 0;
+    if (owner == rank) {
+        std::size_t local = id - rankFirst[rank];
+        if (states[local] == static_cast<std::uint8_t>(HealthState::Susceptible)) {
+            states[local] = static_cast<std::uint8_t>(HealthState::Infected);
+            daysLeft[local] = static_cast<std::uint8_t>(infectionDuration);
+            infected = 1;
+        }
+    }
+    MPI_Bcast(&infected, 1, MPI_INT, owner, comm);
+    countSusceptible -= infected;
+    countInfected += infected;
+}
+
+void DistributedPopulation::setTransmissionParameters(float probability, double contacts) {
+    setInfectionProbability(probability);
+    setContactsPerDay(contacts);
+}
+
+void DistributedPopulation::simulateOneDay() {
+    const std::uint8_t susceptible = static_cast<std::uint8_t>(HealthState::Susceptible);
+    const std::uint8_t infected = static_cast<std::uint8_t>(HealthState::Infected);
+    const std::uint32_t first = rankFirst[rank];
+    const std::uint32_t last = rankFirst[rank + 1];
+    // A fractional mean is one extra contact with that probability
+    const double meanContacts = std::min(contactsPerDay, size - 1.0);
+    const int wholeContacts = static_cast<int>(meanContacts);
+    const double extraContact = meanContacts - wholeContacts;
+    const std::uint64_t dayStream = streamSeed(seed, static_cast<std::uint64_t>(day));
+
+    // Transmission from start-of-day states; each agent draws from its own (seed, day, id) stream
+    localAttempts.clear();
+    for (std::vector<std::uint32_t>& buffer : outgoing) {
+        buffer.clear();
+    }
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        if (states[i] != infected) {
+            continue;
+        }
+        SplitMix64 rng(streamSeed(dayStream, first + i));
+        const int contacts = wholeContacts + (extraContact > 0.0 && unitInterval(rng()) < extraContact);
+        for (int c = 0; c < contacts; ++c) {
+            std::uint32_t contact = static_cast<std::uint32_t>(boundedRandom(rng(), static_cast<std::uint64_t>(size)));
+            if (unitInterval(rng()) > infectionProbability) {
+                continue;
+            }
+            if (contact >= first && contact < last) {
+                if (states[contact - first] == susceptible) {
+                    localAttempts.push_back(contact);
+                }
+            } else {
+                outgoing[ownerOf(contact)].push_back(contact);
+            }
+        }
+    }
+
+    // One batched exchange of the cross-rank attempts
+    std::vector<int> sendCounts(rankCount), sendOffsets(rankCount), receiveCounts(rankCount), receiveOffsets(rankCount);
+    sendBuffer.clear();
+    for (int r = 0; r < rankCount; ++r) {
+        sendOffsets[r] = static_cast<int>(sendBuffer.size());
+        sendCounts[r] = static_cast<int>(outgoing[r].size());
+        sendBuffer.insert(sendBuffer.end(), outgoing[r].begin(), outgoing[r].end());
+    }
+    exchangedAttempts += sendBuffer.size();
+    MPI_Alltoall(sendCounts.data(), 1, MPI_INT, receiveCounts.data(), 1, MPI_INT, comm);
+    int received = 0;
+    for (int r = 0; r < rankCount; ++r) {
+        receiveOffsets[r] = received;
+        received += receiveCounts[r];
+    }
+    receiveBuffer.resize(received);
+    MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendOffsets.data(), MPI_UINT32_T,
+                  receiveBuffer.data(), receiveCounts.data(), receiveOffsets.data(), MPI_UINT32_T, comm);
+
+    // Progression of local agents, fused with the S/I/R histogram
+    StateCounts counts = progressAndCountStates(states.data(), daysLeft.data(), states.size());
+
+    // Apply local and received attempts to agents that are still susceptible
+    for (const std::vector<std::uint32_t>* attempts : {&localAttempts, &receiveBuffer}) {
+        for (std::uint32_t id : *attempts) {
+            std::size_t local = id - first;
+            if (states[local] == susceptible) {
+                states[local] = infected;
+                daysLeft[local] = static_cast<std::uint8_t>(infectionDuration);
+                counts.susceptible--;
+                counts.infected++;
+            }
+        }
+    }
+
+    reduceCounts(counts.susceptible, counts.infected, counts.recovered);
+    day++;
+}
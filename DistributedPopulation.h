@@ -0,0 +1,189 @@
+/**
+ * @file DistributedPopulation.h
+ * @brief Agent population partitioned across MPI ranks
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the DistributedPopulation class which runs the agent-based
+ * SIR model of Population on a single population too large for one node by
+ * giving every MPI rank a contiguous block of agents.
+ *
+ * Only available in MPI builds (`make mpi`, which defines SIR_WITH_MPI).
+ */
+
+#ifndef DISTRIBUTED_POPULATION_H
+#define DISTRIBUTED_POPULATION_H
+
+#ifndef SIR_WITH_MPI
+#error "DistributedPopulation requires an MPI build (make mpi)"
+#endif
+
+#include "EpidemicModel.h"
+#include "Random.h"
+#include <mpi.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Homogeneous-mixing agent population distributed over MPI ranks
+ *
+ * Rank r owns the global agent IDs [N * r / P, N * (r + 1) / P) as
+ * byte-per-agent state arrays. Each day:
+ * - every local infected agent makes min(contactsPerDay, N - 1) contacts with
+ *   uniformly random global IDs; each contact also draws its transmission
+ *   coin, and successful contacts become infection attempts
+ * - attempts on remote agents are batched per destination rank and exchanged
+ *   once with MPI_Alltoallv
+ * - each rank progresses its agents with the state kernels, applies local and
+ *   received attempts to agents that are still susceptible, and the S/I/R
+ *   totals are combined with MPI_Allreduce
+ *
+ * All draws of an agent come from a counter-based stream keyed by
+ * (seed, day, global ID), and applying an attempt is idempotent, so for a
+ * fixed seed the trajectory is identical for any number of ranks.
+ *
+ * @note Every method except the getters is collective: all ranks must call it
+ *       in the same order with the same arguments.
+ */
+class DistributedPopulation : public EpidemicModel {
+private:
+    MPI_Comm comm;                          ///< Communicator spanning the partition
+    int rank;                               ///< Rank of this process in comm
+    int rankCount;                          ///< Number of ranks in comm
+
+    int size;                               ///< Global population size
+    int day;                                ///< Current simulation day
+    int countSusceptible;                   ///< Global number of susceptible individuals
+    int countInfected;                      ///< Global number of infected individuals
+    int countRecovered;                     ///< Global number of recovered individuals
+    std::int64_t countImmunized;            ///< Global susceptibles moved to recovered by vaccination
+
+    float infectionProbability;             ///< Probability of infection upon contact
+    double contactsPerDay;                  ///< Mean contacts per infected person per day
+    int infectionDuration;                  ///< Duration of infection in days
+
+    std::vector<std::uint32_t> rankFirst;   ///< Rank r owns global IDs [rankFirst[r], rankFirst[r + 1])
+    std::vector<std::uint8_t> states;       ///< HealthState code of each local agent
+    std::vector<std::uint8_t> daysLeft;     ///< Remaining infectious days of each local agent
+
+    std::uint64_t seed;                     ///< Base seed of the counter-based streams
+    SplitMix64 seedingRng;                  ///< Replicated generator for infectRandomPerson()
+
+    // Day buffers (kept between days to reuse their capacity)
+    std::vector<std::vector<std::uint32_t>> outgoing;   ///< Attempts per destination rank
+    std::vector<std::uint32_t> sendBuffer;  ///< Outgoing attempts packed by destination rank
+    std::vector<std::uint32_t> receiveBuffer;   ///< Attempts received from all ranks
+    std::vector<std::uint32_t> localAttempts;   ///< Attempts on local agents
+    std::uint64_t exchangedAttempts;        ///< Attempts sent by this rank so far
+
+    /**
+     * @brief Gets the rank owning a global agent ID
+     */
+    int ownerOf(std::uint32_t id) const;
+
+    /**
+     * @brief Infects a global ID if this rank owns it and it is susceptible
+     *
+     * @return 1 if the infection took effect here, else 0
+     */
+    int infectOwned(std::uint32_t id);
+
+    /**
+     * @brief Recomputes the global S/I/R totals from local counts
+     */
+    void reduceCounts(std::int64_t susceptible, std::int64_t infected, std::int64_t recovered);
+
+public:
+    /**
+     * @brief Constructor with an all-susceptible population (collective)
+     *
+     * @param populationSize Global number of individuals
+     * @param communicator Communicator whose ranks share the population
+     * @throws std::invalid_argument if the population is smaller than the rank count
+     */
+    DistributedPopulation(int populationSize, MPI_Comm communicator = MPI_COMM_WORLD);
+
+    void setSeed(unsigned int seedValue) override;
+
+    /**
+     * @brief Restores the all-susceptible day 0 and reseeds (collective)
+     */
+    void reset(unsigned int seedValue) override;
+
+    /**
+     * @brief Infects one uniformly chosen individual (collective)
+     *
+     * Every rank draws the same ID from a replicated stream; the owner applies
+     * the infection and broadcasts whether it took effect.
+     */
+    void infectRandomPerson() override;
+
+    /**
+     * @brief Infects exactly count distinct susceptible individuals (collective)
+     *
+     * Every rank draws the same candidate IDs from the replicated stream,
+     * rejecting IDs drawn before; owners apply them and the number that took
+     * effect is reduced, so further rounds replace draws that hit
+     * non-susceptible individuals.
+     *
+     * @throws std::invalid_argument if count is negative or exceeds the susceptible count
+     */
+    void infectRandomPeople(int count) override;
+
+    /**
+     * @brief Infects the listed global IDs (collective; every rank passes the same list)
+     *
+     * @throws std::out_of_range if an ID is out of range
+     */
+    void infectPeople(const std::vector<std::uint32_t>& ids) override;
+
+    /**
+     * @brief Moves the susceptible agents of a dose batch to recovered
+     *
+     * Collective: every rank passes the same batch and updates the IDs it owns.
+     *
+     * @return Number of agents vaccinated on all ranks
+     * @throws std::out_of_range if an ID is out of range
+     */
+    int vaccinatePeople(const std::uint32_t* ids, std::size_t count) override;
+
+    /**
+     * @brief Sets the infection probability and the contacts per day
+     *
+     * Each infected agent draws floor(c) contacts plus one more with
+     * probability frac(c), from its (seed, day, agent ID) stream.
+     */
+    void setTransmissionParameters(float infectionProbability, double contactsPerDay) override;
+
+    /**
+     * @brief Advances the simulation by one day (collective)
+     */
+    void simulateOneDay() override;
+
+    void setInfectionProbability(float probability);
+    void setContactsPerDay(double contacts);
+
+    /**
+     * @brief Sets the duration of infection in days
+     *
+     * @param days Duration in days (1..MAX_INFECTION_DURATION)
+     * @throws std::invalid_argument if days is out of range
+     */
+    void setInfectionDuration(int days);
+
+    int getCurrentDay() const override { return day; }
+    int getPopulationSize() const override { return size; }
+    int getSusceptibleCount() const override { return countSusceptible; }
+    int getInfectedCount() const override { return countInfected; }
+    int getRecoveredCount() const override { return countRecovered; }
+    std::int64_t getCumulativeInfections() const override {
+        return static_cast<std::int64_t>(size) - countSusceptible - countImmunized;
+    }
+
+    int getRank() const { return rank; }
+    int getRankCount() const { return rankCount; }
+    int getLocalSize() const { return static_cast<int>(states.size()); }
+    std::uint64_t getExchangedAttempts() const { return exchangedAttempts; }
+};
+
+#endif // DISTRIBUTED_POPULATION_H
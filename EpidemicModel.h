@@ -0,0 +1,159 @@
+/**
+ * @file EpidemicModel.h
+ * @brief Common interface of the epidemic simulation engines
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * Every engine (agent-based Population, aggregate stochastic solvers, ...)
+ * exposes the same day-stepped S/I/R view so that SIRSimulation can drive
+ * any of them and produce identical trajectory output.
+ */
+
+#ifndef EPIDEMIC_MODEL_H
+#define EPIDEMIC_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Abstract day-stepped SIR engine
+ *
+ * Implementations advance their internal state in whole-day increments and
+ * report the compartment counts at the end of each day.
+ */
+class EpidemicModel {
+public:
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~EpidemicModel() = default;
+
+    /**
+     * @brief Seeds the engine's random number generator
+     *
+     * Two runs with the same seed and parameters produce identical trajectories.
+     *
+     * @param seed Random seed
+     */
+    virtual void setSeed(unsigned int seed) = 0;
+
+    /**
+     * @brief Restores day 0 with everyone susceptible and reseeds
+     *
+     * Parameters, contact structure and working buffers are kept, so an
+     * ensemble can run many replicates on one engine without reallocating.
+     * After reset(seed) the engine behaves exactly like a freshly built one
+     * given setSeed(seed).
+     *
+     * @param seed Random seed of the next replicate
+     */
+    virtual void reset(unsigned int seed) = 0;
+
+    /**
+     * @brief Moves one susceptible individual into the infected compartment
+     */
+    virtual void infectRandomPerson() = 0;
+
+    /**
+     * @brief Infects exactly count distinct, uniformly chosen susceptible individuals
+     *
+     * Sampling is without replacement. The default repeats infectRandomPerson(),
+     * which is exact for engines on aggregate counts; agent engines override it.
+     *
+     * @param count Number of individuals to infect
+     * @throws std::invalid_argument if count is negative or exceeds the susceptible count
+     */
+    virtual void infectRandomPeople(int count) {
+        if (count < 0 || count > getSusceptibleCount()) {
+            throw std::invalid_argument("Cannot infect more people than are susceptible");
+        }
+        for (int i = 0; i < count; ++i) {
+            infectRandomPerson();
+        }
+    }
+
+    /**
+     * @brief Infects the listed individuals
+     *
+     * Individuals that are not susceptible (including repeated IDs) are skipped.
+     *
+     * @param ids Agent IDs (0 <= id < population size)
+     * @throws std::logic_error if the engine does not track individuals
+     * @throws std::out_of_range if an ID is out of range (before anyone is infected)
+     */
+    virtual void infectPeople(const std::vector<std::uint32_t>& /*ids*/) {
+        throw std::logic_error("Engine does not track individuals");
+    }
+
+    /**
+     * @brief Vaccinates a batch of listed individuals
+     *
+     * Every ID is one dose. Susceptible individuals move to the engine's
+     * vaccination compartment (recovered unless the compartment model has a
+     * vaccinated one); doses given to anyone else have no effect. The cost is
+     * O(count), independent of the population size.
+     *
+     * @param ids Distinct agent IDs (0 <= id < population size)
+     * @param count Number of IDs
+     * @return Number of individuals that left the susceptible compartment
+     * @throws std::logic_error if the engine does not track individuals
+     * @throws std::out_of_range if an ID is out of range
+     */
+    virtual int vaccinatePeople(const std::uint32_t* /*ids*/, std::size_t /*count*/) {
+        throw std::logic_error("Engine does not track individuals");
+    }
+
+    /**
+     * @brief Changes the transmission parameters from the next simulated day on
+     *
+     * Agent engines keep fractional contacts as a mean: each infected agent
+     * makes the whole part, plus one more with the probability of the
+     * fractional part (contacts along a network or from a contact matrix
+     * ignore it). Aggregate engines set the infection rate
+     * beta = probability * contacts.
+     *
+     * @param infectionProbability Probability of infection upon contact (0..1)
+     * @param contactsPerDay Contacts per infected individual per day (>= 0)
+     */
+    virtual void setTransmissionParameters(float infectionProbability, double contactsPerDay) = 0;
+
+    /**
+     * @brief Advances the simulation by one day
+     */
+    virtual void simulateOneDay() = 0;
+
+    virtual int getCurrentDay() const = 0;
+    virtual int getPopulationSize() const = 0;
+    virtual int getSusceptibleCount() const = 0;
+    virtual int getInfectedCount() const = 0;
+    virtual int getRecoveredCount() const = 0;
+
+    /**
+     * @brief Gets the number of exposed (infected, not yet infectious) individuals
+     *
+     * Engines without a latent stage report 0; S + E + I + R + V is the population size.
+     */
+    virtual int getExposedCount() const { return 0; }
+
+    /**
+     * @brief Gets the number of individuals in a separate vaccinated compartment
+     *
+     * Engines that vaccinate into the recovered compartment report 0.
+     */
+    virtual int getVaccinatedCount() const { return 0; }
+
+    /**
+     * @brief Gets the number of infections since day 0, initial infections included
+     *
+     * The default, N - S, holds for engines whose susceptibles only leave by
+     * infection; engines with vaccination or waning immunity override it.
+     * Daily incidence is the difference between two days.
+     */
+    virtual std::int64_t getCumulativeInfections() const {
+        return static_cast<std::int64_t>(getPopulationSize()) - getSusceptibleCount();
+    }
+};
+
+#endif // EPIDEMIC_MODEL_H
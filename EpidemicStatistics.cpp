@@ -0,0 +1,152 @@
+/**
+ * @file EpidemicStatistics.cpp
+ * @brief Implementation of the online epidemic summary statistics
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "EpidemicStatistics.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+const std::int64_t EpidemicStatistics::MIN_WINDOW_CASES;
+
+EpidemicStatistics::EpidemicStatistics(int latent, int infectious, int windowDays)
+    : latentDays(latent), infectiousDays(infectious), window(windowDays) {
+    if (latentDays < 0 || infectiousDays < 1 || window < 1) {
+        throw std::invalid_argument("Statistics need latent days >= 0, infectious days >= 1 and a window >= 1");
+    }
+    incidence.resize(static_cast<std::size_t>(std::max(2 * window, latentDays + infectiousDays + 1)) + 1);
+    pressure.resize(static_cast<std::size_t>(window));
+    reset();
+}
+
+void EpidemicStatistics::reset() {
+    std::fill(incidence.begin(), incidence.end(), 0);
+    std::fill(pressure.begin(), pressure.end(), 0);
+    observed = 0;
+    lastCumulative = 0;
+    recentIncidence = 0;
+    previousIncidence = 0;
+    pressureSum = 0;
+    recentPressure = 0;
+    todayIncidence = 0;
+    lastDay = 0;
+    peakInfected = 0;
+    peakInfectedDay = 0;
+    peakIncidence = 0;
+    peakIncidenceDay = 0;
+    endDay = -1;
+    maxGrowthRate = -std::numeric_limits<double>::infinity();
+    maxGrowthDay = -1;
+    reproductionAtMaxGrowth = std::numeric_limits<double>::quiet_NaN();
+}
+
+std::int64_t EpidemicStatistics::at(std::int64_t lag) const {
+    const std::int64_t t = observed - lag;
+    return t >= 0 ? incidence[static_cast<std::size_t>(t % static_cast<std::int64_t>(incidence.size()))] : 0;
+}
+
+void EpidemicStatistics::observe(const EpidemicSnapshot& snapshot) {
+    // Day 0 counts the initial infections; a shrinking total (never expected) counts as none
+    const std::int64_t today = observed == 0 ? snapshot.cumulativeInfections
+                                             : std::max<std::int64_t>(0, snapshot.cumulativeInfections - lastCumulative);
+    lastCumulative = snapshot.cumulativeInfections;
+    todayIncidence = today;
+    lastDay = snapshot.day;
+    incidence[static_cast<std::size_t>(observed % static_cast<std::int64_t>(incidence.size()))] = today;
+
+    // Running window sums: each adds today's entry and drops the one leaving the window
+    recentIncidence += today - at(window);
+    previousIncidence += at(window) - at(2 * window);
+    pressureSum += at(latentDays + 1) - at(latentDays + infectiousDays + 1);
+    const std::size_t slot = static_cast<std::size_t>(observed % window);
+    recentPressure += pressureSum - pressure[slot];
+    pressure[slot] = pressureSum;
+    observed++;
+
+    if (snapshot.infected > peakInfected) {
+        peakInfected = snapshot.infected;
+        peakInfectedDay = snapshot.day;
+    }
+    if (observed > 1 && today > peakIncidence) {
+        peakIncidence = today;
+        peakIncidenceDay = snapshot.day;
+    }
+    if (snapshot.infected == 0 && snapshot.exposed == 0) {
+        if (endDay < 0) {
+            endDay = snapshot.day;
+        }
+    } else {
+        endDay = -1;
+    }
+    if (hasGrowthRate() && getGrowthRate() > maxGrowthRate) {
+        maxGrowthRate = getGrowthRate();
+        maxGrowthDay = snapshot.day;
+        reproductionAtMaxGrowth = getReproductionNumber();
+    }
+}
+
+bool EpidemicStatistics::hasGrowthRate() const {
+    return observed >= 2 * window && recentIncidence >= MIN_WINDOW_CASES && previousIncidence >= MIN_WINDOW_CASES;
+}
+
+double EpidemicStatistics::getGrowthRate() const {
+    if (!hasGrowthRate()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return std::log(static_cast<double>(recentIncidence) / static_cast<double>(previousIncidence)) / window;
+}
+
+double EpidemicStatistics::getDoublingTime() const {
+    return std::log(2.0) / getGrowthRate();
+}
+
+double EpidemicStatistics::getReproductionNumber() const {
+    // The window must be past day 0, whose initial infections have no infectors
+    if (observed <= window || recentPressure <= 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return static_cast<double>(recentIncidence) * infectiousDays / static_cast<double>(recentPressure);
+}
+
+double EpidemicStatistics::getMaxGrowthRate() const {
+    return maxGrowthDay >= 0 ? maxGrowthRate : std::numeric_limits<double>::quiet_NaN();
+}
+
+std::string EpidemicStatistics::toString(int populationSize) const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "Peak Infected: " << peakInfected << " (" << 100.0 * peakInfected / populationSize << "%) on day "
+        << peakInfectedDay << "\n";
+    oss << "Peak Incidence: " << peakIncidence << "/day on day " << peakIncidenceDay << "\n";
+    oss << "Cumulative Incidence: " << lastCumulative << " (" << 100.0 * lastCumulative / populationSize
+        << "%)\n";
+    if (endDay >= 0) {
+        oss << "Epidemic End: day " << endDay << "\n";
+    } else {
+        oss << "Epidemic End: not reached by day " << lastDay << "\n";
+    }
+    oss << std::setprecision(2);
+    if (maxGrowthDay >= 0 && maxGrowthRate > 0.0) {
+        oss << "Fastest Growth: doubling every " << std::log(2.0) / maxGrowthRate << " days on day "
+            << maxGrowthDay;
+        if (!std::isnan(reproductionAtMaxGrowth)) {
+            oss << " (R_t " << reproductionAtMaxGrowth << ")";
+        }
+        oss << "\n";
+    }
+    if (!std::isnan(getReproductionNumber())) {
+        oss << "Final R_t: " << getReproductionNumber();
+        if (hasGrowthRate()) {
+            oss << " (" << (getGrowthRate() >= 0.0 ? "doubling" : "halving") << " time "
+                << std::fabs(getDoublingTime()) << " days)";
+        }
+        oss << "\n";
+    }
+    return oss.str();
+}
@@ -0,0 +1,176 @@
+/**
+ * @file EpidemicStatistics.h
+ * @brief Online summary statistics of an epidemic trajectory
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the per-day EpidemicSnapshot read from an engine and the
+ * EpidemicStatistics accumulator that summarizes a run (peaks, incidence,
+ * growth rate, doubling time, effective reproduction number) in O(1) work
+ * per day without storing the trajectory.
+ */
+
+#ifndef EPIDEMIC_STATISTICS_H
+#define EPIDEMIC_STATISTICS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Compartment counts at the end of a simulated day
+ *
+ * Filled once per day by the simulation driver from the engine's counters
+ * and shared by the statistics and every stopping criterion.
+ */
+struct EpidemicSnapshot {
+    int day;                    ///< Days simulated so far
+    int populationSize;         ///< Total population
+    int susceptible;            ///< Susceptible individuals
+    int exposed;                ///< Exposed (latent) individuals
+    int infected;               ///< Infectious individuals
+    int recovered;              ///< Recovered individuals
+    std::int64_t vaccinated;    ///< Individuals moved out of S by vaccination
+    std::int64_t cumulativeInfections;  ///< Infections since day 0 (EpidemicModel::getCumulativeInfections())
+    double elapsedSeconds;      ///< Wall time since the run started
+
+    /**
+     * @brief Gets the individuals ever infected (left S other than by vaccination)
+     */
+    std::int64_t getAffected() const {
+        const std::int64_t affected = static_cast<std::int64_t>(populationSize) - susceptible - vaccinated;
+        return affected > 0 ? affected : 0;
+    }
+};
+
+/**
+ * @brief Running summary of one trajectory, updated once per day
+ *
+ * Daily incidence is the change in cumulative infections (day 0 counts the
+ * initial infections). Estimates over a window of W days:
+ *
+ * - Growth rate r = ln(incidence over the last W days / the W days before) / W,
+ *   available from day 2W - 1 while both windows hold at least
+ *   MIN_WINDOW_CASES infections (fewer make it mostly noise); the doubling
+ *   time is ln 2 / r (negative while the epidemic shrinks: a halving time)
+ * - Effective reproduction number R_t from the renewal equation (as in Cori
+ *   et al.): incidence over the last W days divided by the infection pressure
+ *   sum over s of incidence(t - s) * w(s), with the generation interval w
+ *   uniform over lags latentDays + 1 .. latentDays + infectiousDays. That is
+ *   exact for the agent engines' fixed disease course; for the aggregate
+ *   engines (exponential periods) it is an approximation biased towards 1.
+ *
+ * Incidence is kept in a ring of max(2W, latentDays + infectiousDays + 1) + 1
+ * days with running window sums, so observe() is O(1) and the memory does
+ * not grow with the run.
+ */
+class EpidemicStatistics {
+public:
+    /// Infections each growth-rate window needs for an estimate
+    static const std::int64_t MIN_WINDOW_CASES = 50;
+
+private:
+    int latentDays;                         ///< Generation interval: days before infectiousness
+    int infectiousDays;                     ///< Generation interval: infectious days
+    int window;                             ///< Smoothing window W in days
+    std::vector<std::int64_t> incidence;    ///< Ring of daily incidence
+    std::vector<std::int64_t> pressure;     ///< Ring of the last W infection-pressure sums (times infectiousDays)
+
+    std::int64_t observed;                  ///< Days observed (including day 0)
+    std::int64_t lastCumulative;            ///< Cumulative infections on the last observed day
+    std::int64_t recentIncidence;           ///< Incidence over the last W days
+    std::int64_t previousIncidence;         ///< Incidence over the W days before those
+    std::int64_t pressureSum;               ///< Incidence over the generation-interval lags
+    std::int64_t recentPressure;            ///< Sum of pressureSum over the last W days
+
+    std::int64_t todayIncidence;            ///< Incidence of the last observed day
+    int lastDay;                            ///< Last observed day
+    int peakInfected;                       ///< Highest infected count
+    int peakInfectedDay;                    ///< First day it was reached
+    std::int64_t peakIncidence;             ///< Highest daily incidence (days >= 1)
+    int peakIncidenceDay;                   ///< First day it was reached
+    int endDay;                             ///< First day with no infected or exposed (-1 while active)
+    double maxGrowthRate;                   ///< Fastest growth rate estimate
+    int maxGrowthDay;                       ///< Day of the fastest growth (-1 if none)
+    double reproductionAtMaxGrowth;         ///< R_t on that day (NaN if not yet estimable)
+
+    std::int64_t at(std::int64_t lag) const;
+
+public:
+    /**
+     * @brief Builds an empty accumulator for a disease course
+     *
+     * @param latentDays Days from infection to infectiousness (>= 0)
+     * @param infectiousDays Infectious days (>= 1)
+     * @param window Smoothing window in days (>= 1)
+     * @throws std::invalid_argument if a parameter is out of range
+     */
+    EpidemicStatistics(int latentDays, int infectiousDays, int window = 7);
+
+    /**
+     * @brief Forgets every observation (for a new replicate)
+     */
+    void reset();
+
+    /**
+     * @brief Adds the counts at the end of a day
+     *
+     * Called once for day 0 (after seeding) and once after every simulated day.
+     */
+    void observe(const EpidemicSnapshot& snapshot);
+
+    int getDaysObserved() const { return static_cast<int>(observed); }
+    int getPeakInfected() const { return peakInfected; }
+    int getPeakInfectedDay() const { return peakInfectedDay; }
+    std::int64_t getPeakIncidence() const { return peakIncidence; }
+    int getPeakIncidenceDay() const { return peakIncidenceDay; }
+    std::int64_t getIncidence() const { return todayIncidence; }
+    std::int64_t getCumulativeIncidence() const { return lastCumulative; }
+
+    /**
+     * @brief Gets the first day with no infected or exposed individuals
+     *
+     * @return The day, or -1 while the epidemic is still active
+     */
+    int getEndDay() const { return endDay; }
+
+    /**
+     * @brief Whether the growth rate is estimable on the last observed day
+     */
+    bool hasGrowthRate() const;
+
+    /**
+     * @brief Gets the current growth rate r (per day; NaN if not estimable)
+     */
+    double getGrowthRate() const;
+
+    /**
+     * @brief Gets the current doubling time ln 2 / r in days (NaN if not estimable)
+     */
+    double getDoublingTime() const;
+
+    /**
+     * @brief Gets the current effective reproduction number R_t (NaN if not estimable)
+     */
+    double getReproductionNumber() const;
+
+    /**
+     * @brief Gets the fastest growth rate seen (NaN if none was estimable)
+     */
+    double getMaxGrowthRate() const;
+    int getMaxGrowthDay() const { return maxGrowthDay; }
+
+    /**
+     * @brief Gets R_t on the day of the fastest growth (NaN if not estimable then)
+     */
+    double getReproductionAtMaxGrowth() const { return reproductionAtMaxGrowth; }
+
+    /**
+     * @brief Formats the summary as "Label: value" lines
+     *
+     * @param populationSize Denominator of the percentages
+     */
+    std::string toString(int populationSize) const;
+};
+
+#endif // EPIDEMIC_STATISTICS_H
@@ -0,0 +1,92 @@
+/**
+ * @file GillespieModel.cpp
+ * @brief Implementation of the Gillespie direct-method SIR engine
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "GillespieModel.h"
+#include <cmath>
+#include <stdexcept>
+
+GillespieModel::GillespieModel(int populationSize)
+    : size(populationSize), day(0), time(0.0),
+      countSusceptible(populationSize), countInfected(0), countRecovered(0),
+      infectionRate(0.0), recoveryRate(0.0), eventCount(0) {
+    if (populationSize <= 0) {
+        throw std::invalid_argument("Population size must be positive");
+    }
+}
+
+void GillespieModel::setInfectionRate(double beta) {
+    if (beta < 0.0) {
+        throw std::invalid_argument("Infection rate must be non-negative");
+    }
+    infectionRate = beta;
+}
+
+void GillespieModel::setRecoveryRate(double gamma) {
+    if (gamma < 0.0) {
+        throw std::invalid_argument("Recovery rate must be non-negative");
+    }
+    recoveryRate = gamma;
+}
+
+void GillespieModel::setSeed(unsigned int seed) {
+    rng.seed(seed);
+}
+
+void GillespieModel::reset(unsigned int seed) {
+    day = 0;
+    time = 0.0;
+    countSusceptible = size;
+    countInfected = 0;
+    countRecovered = 0;
+    eventCount = 0;
+    setSeed(seed);
+}
+
+void GillespieModel::infectRandomPerson() {
+    if (countSusceptible > 0) {
+        countSusceptible--;
+        countInfected++;
+    }
+}
+
+void GillespieModel::setTransmissionParameters(float probability, double contacts) {
+    setInfectionRate(static_cast<double>(probability) * contacts);
+}
+
+void GillespieModel::simulateOneDay() {
+    const double dayEnd = day + 1.0;
+    const double infectionScale = infectionRate / size;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    while (countInfected > 0) {
+        double infectionPropensity = infectionScale * countSusceptible * countInfected;
+        double totalPropensity = infectionPropensity + recoveryRate * countInfected;
+        if (totalPropensity <= 0.0) {
+            break;
+        }
+
+        // Waiting time ~ Exp(totalPropensity); 1 - u avoids log(0)
+        double waiting = -std::log(1.0 - uniform(rng)) / totalPropensity;
+        if (time + waiting >= dayEnd) {
+            break;
+        }
+        time += waiting;
+
+        // Select the reaction channel in proportion to its propensity
+        if (uniform(rng) * totalPropensity < infectionPropensity) {
+            countSusceptible--;
+            countInfected++;
+        } else {
+            countInfected--;
+            countRecovered++;
+        }
+        eventCount++;
+    }
+
+    time = dayEnd;
+    day++;
+}
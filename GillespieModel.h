@@ -0,0 +1,108 @@
+/**
+ * @file GillespieModel.h
+ * @brief Exact continuous-time stochastic SIR engine (Gillespie direct method)
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the GillespieModel class which simulates the SIR Markov
+ * jump process exactly on aggregate compartment counts.
+ */
+
+#ifndef GILLESPIE_MODEL_H
+#define GILLESPIE_MODEL_H
+
+#include "EpidemicModel.h"
+#include <random>
+
+/**
+ * @brief Stochastic simulation algorithm (SSA) on aggregate S/I/R counts
+ *
+ * The model has two reaction channels:
+ * - Infection:  S + I -> 2I  with propensity beta * S * I / N
+ * - Recovery:   I -> R       with propensity gamma * I
+ *
+ * Each event costs O(1) time and the model stores no per-agent data, so it is
+ * suited to very many replicates of small populations. Event times are exact;
+ * simulateOneDay() fires every event up to the next day boundary so the output
+ * is sampled on the same daily grid as the agent-based Population.
+ *
+ * @note Because the exponential waiting time is memoryless, the event that would
+ *       overshoot the day boundary is discarded and redrawn on the next day
+ *       without biasing the process.
+ */
+class GillespieModel : public EpidemicModel {
+private:
+    int size;                  ///< Total population size N
+    int day;                   ///< Current simulation day
+    double time;               ///< Continuous simulation time in days
+
+    int countSusceptible;      ///< Number of susceptible individuals
+    int countInfected;         ///< Number of infected individuals
+    int countRecovered;        ///< Number of recovered individuals
+
+    double infectionRate;      ///< Transmission rate beta (per day)
+    double recoveryRate;       ///< Recovery rate gamma (per day)
+    long long eventCount;      ///< Number of reactions fired so far
+
+    std::mt19937_64 rng;       ///< Random number generator
+
+public:
+    /**
+     * @brief Constructor with an all-susceptible population
+     *
+     * @param populationSize Number of individuals (must be > 0)
+     * @throws std::invalid_argument if populationSize <= 0
+     */
+    explicit GillespieModel(int populationSize);
+
+    /**
+     * @brief Sets the transmission rate beta
+     *
+     * For agent-equivalent parameters use contactsPerDay * infectionProbability.
+     *
+     * @param beta Rate per day (must be >= 0)
+     */
+    void setInfectionRate(double beta);
+
+    /**
+     * @brief Sets the recovery rate gamma
+     *
+     * For agent-equivalent parameters use 1 / infectionDuration.
+     *
+     * @param gamma Rate per day (must be >= 0)
+     */
+    void setRecoveryRate(double gamma);
+
+    void setSeed(unsigned int seed) override;
+    void reset(unsigned int seed) override;
+
+    /**
+     * @brief Moves one susceptible individual to the infected compartment
+     *
+     * Has no effect when no susceptible individuals remain.
+     */
+    void infectRandomPerson() override;
+
+    /**
+     * @brief Sets the infection rate to infectionProbability * contactsPerDay
+     */
+    void setTransmissionParameters(float infectionProbability, double contactsPerDay) override;
+
+    /**
+     * @brief Fires all reactions up to the next whole day
+     */
+    void simulateOneDay() override;
+
+    int getCurrentDay() const override { return day; }
+    int getPopulationSize() const override { return size; }
+    int getSusceptibleCount() const override { return countSusceptible; }
+    int getInfectedCount() const override { return countInfected; }
+    int getRecoveredCount() const override { return countRecovered; }
+
+    double getTime() const { return time; }
+    long long getEventCount() const { return eventCount; }
+    double getInfectionRate() const { return infectionRate; }
+    double getRecoveryRate() const { return recoveryRate; }
+};
+
+#endif // GILLESPIE_MODEL_H
@@ -0,0 +1,130 @@
+/**
+ * @file GraphOrdering.cpp
+ * @brief Implementation of degree and reverse Cuthill-McKee node orderings
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "GraphOrdering.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+std::vector<std::uint32_t> degreeOrdering(const ContactNetwork& network) {
+    const std::uint32_t n = network.getNodeCount();
+    std::vector<std::uint32_t> byDegree(n);
+    std::iota(byDegree.begin(), byDegree.end(), 0u);
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return network.getDegree(a) > network.getDegree(b);
+    });
+    std::vector<std::uint32_t> oldToNew(n);
+    for (std::uint32_t rank = 0; rank < n; ++rank) {
+        oldToNew[byDegree[rank]] = rank;
+    }
+    return oldToNew;
+}
+
+std::vector<std::uint32_t> reverseCuthillMcKee(const ContactNetwork& network) {
+    const std::uint32_t n = network.getNodeCount();
+
+    // Component start candidates in ascending degree order
+    std::vector<std::uint32_t> starts(n);
+    std::iota(starts.begin(), starts.end(), 0u);
+    std::stable_sort(starts.begin(), starts.end(), [&](std::uint32_t a, std::uint32_t b) {
+        return network.getDegree(a) < network.getDegree(b);
+    });
+
+    std::vector<std::uint32_t> visitOrder;
+    visitOrder.reserve(n);
+    std::vector<bool> visited(n, false);
+    std::vector<std::uint32_t> frontier;
+    for (std::uint32_t start : starts) {
+        if (visited[start]) {
+            continue;
+        }
+        visited[start] = true;
+        visitOrder.push_back(start);
+        // visitOrder doubles as the BFS queue
+        for (std::size_t head = visitOrder.size() - 1; head < visitOrder.size(); ++head) {
+            std::uint32_t node = visitOrder[head];
+            frontier.clear();
+            for (const std::uint32_t* it = network.neighborsBegin(node); it != network.neighborsEnd(node); ++it) {
+                if (!visited[*it]) {
+                    visited[*it] = true;
+                    frontier.push_back(*it);
+                }
+            }
+            std::sort(frontier.begin(), frontier.end(), [&](std::uint32_t a, std::uint32_t b) {
+                std::uint32_t degreeA = network.getDegree(a), degreeB = network.getDegree(b);
+                return degreeA != degreeB ? degreeA < degreeB : a < b;
+            });
+            visitOrder.insert(visitOrder.end(), frontier.begin(), frontier.end());
+        }
+    }
+
+    std::vector<std::uint32_t> oldToNew(n);
+    for (std::uint32_t position = 0; position < n; ++position) {
+        oldToNew[visitOrder[position]] = n - 1 - position;
+    }
+    return oldToNew;
+}
+
+} // namespace
+
+const char* nodeOrderingName(NodeOrdering ordering) {
+    switch (ordering) {
+        case NodeOrdering::Degree:
+            return "degree";
+        case NodeOrdering::ReverseCuthillMcKee:
+            return "rcm";
+        default:
+            return "none";
+    }
+}
+
+std::vector<std::uint32_t> computeNodeOrdering(const ContactNetwork& network, NodeOrdering ordering) {
+    switch (ordering) {
+        case NodeOrdering::Degree:
+            return degreeOrdering(network);
+        case NodeOrdering::ReverseCuthillMcKee:
+            return reverseCuthillMcKee(network);
+        default: {
+            std::vector<std::uint32_t> identity(network.getNodeCount());
+            std::iota(identity.begin(), identity.end(), 0u);
+            return identity;
+        }
+    }
+}
+
+ContactNetwork relabelNetwork(const ContactNetwork& network, const std::vector<std::uint32_t>& oldToNew,
+                              int threads) {
+    const std::uint32_t n = network.getNodeCount();
+    if (oldToNew.size() != n) {
+        throw std::invalid_argument("Relabeling must cover every node");
+    }
+    std::vector<std::uint32_t> newToOld(n);
+    for (std::uint32_t old = 0; old < n; ++old) {
+        newToOld[oldToNew[old]] = old;
+    }
+
+    std::vector<std::uint64_t> offsets(static_cast<std::size_t>(n) + 1, 0);
+    for (std::uint32_t node = 0; node < n; ++node) {
+        offsets[node + 1] = offsets[node] + network.getDegree(newToOld[node]);
+    }
+    std::vector<std::uint32_t> neighbors(offsets.back());
+    parallelFor(n, threads, [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t node = begin; node < end; ++node) {
+            std::uint32_t old = newToOld[node];
+            std::uint32_t* out = neighbors.data() + offsets[node];
+            std::uint32_t* cursor = out;
+            for (const std::uint32_t* it = network.neighborsBegin(old); it != network.neighborsEnd(old); ++it) {
+                *cursor++ = oldToNew[*it];
+            }
+            std::sort(out, cursor);
+        }
+    });
+    return ContactNetwork(std::move(offsets), std::move(neighbors));
+}
@@ -0,0 +1,176 @@
+/**
+ * @file HybridModel.cpp
+ * @brief Implementation of the prevalence-switched hybrid engine
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "HybridModel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+HybridModel::HybridModel(int populationSize)
+    : agents(populationSize), aggregated(false),
+      switchPrevalence(0.01), returnPrevalence(0.001), switchCount(0),
+      countImmunized(0), day(0), countSusceptible(populationSize), countInfected(0), previousInfected(0) {
+}
+
+void HybridModel::setInfectionProbability(float probability) {
+    agents.setInfectionProbability(probability);
+}
+
+void HybridModel::setContactsPerDay(double contacts) {
+    agents.setContactsPerDay(contacts);
+}
+
+void HybridModel::setInfectionDuration(int days) {
+    agents.setInfectionDuration(days);
+}
+
+void HybridModel::setSwitchThresholds(double switchAt, double returnBelow) {
+    if (switchAt <= 0.0 || switchAt > 1.0 || returnBelow < 0.0 || returnBelow >= switchAt) {
+        throw std::invalid_argument("Hybrid thresholds must satisfy 0 <= return < switch <= 1");
+    }
+    switchPrevalence = switchAt;
+    returnPrevalence = returnBelow;
+}
+
+void HybridModel::setSeed(unsigned int seed) {
+    agents.setSeed(seed);
+    rng.seed(seed);
+}
+
+void HybridModel::reset(unsigned int seed) {
+    agents.reset(seed);
+    rng.seed(seed);
+    aggregated = false;
+    switchCount = 0;
+    countImmunized = 0;
+    day = 0;
+    countSusceptible = agents.getPopulationSize();
+    countInfected = 0;
+    previousInfected = 0;
+    std::fill(cohorts.begin(), cohorts.end(), 0);
+}
+
+void HybridModel::infectRandomPerson() {
+    if (!aggregated) {
+        agents.infectRandomPerson();
+    } else if (countSusceptible > 0) {
+        countSusceptible--;
+        countInfected++;
+        cohorts[agents.getInfectionDuration()]++;
+    }
+}
+
+void HybridModel::infectRandomPeople(int count) {
+    if (!aggregated) {
+        agents.infectRandomPeople(count);
+    } else {
+        EpidemicModel::infectRandomPeople(count);
+    }
+}
+
+void HybridModel::infectPeople(const std::vector<std::uint32_t>& ids) {
+    if (aggregated) {
+        throw std::logic_error("Individuals are not tracked while the aggregated engine is active");
+    }
+    agents.infectPeople(ids);
+}
+
+int HybridModel::vaccinatePeople(const std::uint32_t* ids, std::size_t count) {
+    if (aggregated) {
+        throw std::logic_error("Individuals are not tracked while the aggregated engine is active");
+    }
+    const int vaccinated = agents.vaccinatePeople(ids, count);
+    countImmunized += vaccinated;
+    return vaccinated;
+}
+
+void HybridModel::setTransmissionParameters(float probability, double contacts) {
+    setInfectionProbability(probability);
+    setContactsPerDay(contacts);
+}
+
+void HybridModel::simulateOneDay() {
+    const double size = agents.getPopulationSize();
+    if (aggregated) {
+        previousInfected = countInfected;
+        simulateAggregatedDay();
+        if (countInfected < returnPrevalence * size && countInfected < previousInfected) {
+            switchToAgents();
+        }
+    } else {
+        agents.simulateOneDay();
+        if (agents.getInfectedCount() >= switchPrevalence * size) {
+            switchToAggregated();
+        }
+    }
+}
+
+void HybridModel::simulateAggregatedDay() {
+    const int size = agents.getPopulationSize();
+    const int duration = agents.getInfectionDuration();
+
+    // Every infected individual makes the same number of contacts as in Population
+    const double contacts = std::min(agents.getContactsPerDay(), size - 1.0);
+    const double perContact = static_cast<double>(agents.getInfectionProbability()) / size;
+    double infectionChance = 0.0;
+    if (perContact >= 1.0) {
+        infectionChance = countInfected > 0 && contacts > 0 ? 1.0 : 0.0;
+    } else {
+        infectionChance = -std::expm1(contacts * countInfected * std::log1p(-perContact));
+    }
+    int newInfections = 0;
+    if (countSusceptible > 0 && infectionChance > 0.0) {
+        std::binomial_distribution<int> binomial(countSusceptible, std::min(infectionChance, 1.0));
+        newInfections = binomial(rng);
+    }
+
+    // Age the cohorts: the one-day cohort recovers
+    int recoveries = cohorts[1];
+    std::copy(cohorts.begin() + 2, cohorts.end(), cohorts.begin() + 1);
+    cohorts[duration] = newInfections;
+
+    countSusceptible -= newInfections;
+    countInfected += newInfections - recoveries;
+    day++;
+}
+
+void HybridModel::switchToAggregated() {
+    agents.getDaysLeftHistogram(cohorts);
+    day = agents.getCurrentDay();
+    countSusceptible = agents.getSusceptibleCount();
+    countInfected = agents.getInfectedCount();
+    previousInfected = countInfected;
+    aggregated = true;
+    switchCount++;
+}
+
+void HybridModel::switchToAgents() {
+    agents.loadCompartments(day, countSusceptible, cohorts);
+    aggregated = false;
+    switchCount++;
+}
+
+int HybridModel::getCurrentDay() const {
+    return aggregated ? day : agents.getCurrentDay();
+}
+
+int HybridModel::getSusceptibleCount() const {
+    return aggregated ? countSusceptible : agents.getSusceptibleCount();
+}
+
+int HybridModel::getInfectedCount() const {
+    return aggregated ? countInfected : agents.getInfectedCount();
+}
+
+std::int64_t HybridModel::getCumulativeInfections() const {
+    return static_cast<std::int64_t>(agents.getPopulationSize()) - getSusceptibleCount() - countImmunized;
+}
+
+int HybridModel::getRecoveredCount() const {
+    return aggregated ? agents.getPopulationSize() - countSusceptible - countInfected
+                      : agents.getRecoveredCount();
+}
@@ -0,0 +1,135 @@
+/**
+ * @file HybridModel.h
+ * @brief Hybrid agent/compartmental engine that switches representation by prevalence
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the HybridModel class which runs the agent-based
+ * Population while prevalence is low and an aggregated chain-binomial engine
+ * while it is high.
+ */
+
+#ifndef HYBRID_MODEL_H
+#define HYBRID_MODEL_H
+
+#include "EpidemicModel.h"
+#include "Population.h"
+#include <random>
+#include <vector>
+
+/**
+ * @brief Prevalence-switched combination of the agent and aggregated engines
+ *
+ * The aggregated representation is a chain-binomial model with the same
+ * day-step semantics as Population: infected individuals are kept in cohorts
+ * by remaining infectious days, each day every susceptible escapes all
+ * min(contactsPerDay, N - 1) * I contacts with probability
+ * (1 - infectionProbability / N)^(contacts * I), cohorts age by one day, and
+ * the new infections enter with the full duration. Because cohorts carry the
+ * remaining days, switching in either direction preserves S, I, R and every
+ * infected individual's remaining days exactly.
+ *
+ * - Agent -> aggregated when I / N reaches the switch prevalence
+ * - Aggregated -> agent when I / N falls below the return prevalence while
+ *   prevalence is declining (the epidemic tail); a return prevalence of 0
+ *   keeps the aggregated engine until the end
+ *
+ * @note Valid for homogeneous mixing only, where individuals are exchangeable.
+ */
+class HybridModel : public EpidemicModel {
+private:
+    Population agents;                 ///< Agent representation (authoritative while !aggregated)
+    bool aggregated;                   ///< True while the chain-binomial engine is active
+    double switchPrevalence;           ///< I/N at which the aggregated engine takes over
+    double returnPrevalence;           ///< I/N below which agents are restored in the tail
+    int switchCount;                   ///< Number of representation changes
+    std::int64_t countImmunized;       ///< Susceptibles moved to recovered by vaccination
+
+    // Aggregated state (valid while aggregated)
+    int day;                           ///< Current simulation day
+    int countSusceptible;              ///< Number of susceptible individuals
+    int countInfected;                 ///< Number of infected individuals
+    int previousInfected;              ///< I on the previous day (to detect the decline)
+    std::vector<int> cohorts;          ///< cohorts[d] = infected with d days left
+
+    std::mt19937_64 rng;               ///< Random number generator for the aggregated engine
+
+    /**
+     * @brief Advances the aggregated chain-binomial engine by one day
+     */
+    void simulateAggregatedDay();
+
+    /**
+     * @brief Moves the state into cohorts and activates the aggregated engine
+     */
+    void switchToAggregated();
+
+    /**
+     * @brief Writes the cohorts back into the agent arrays and reactivates agents
+     */
+    void switchToAgents();
+
+public:
+    /**
+     * @brief Constructor with an all-susceptible population
+     *
+     * @param populationSize Number of individuals
+     */
+    explicit HybridModel(int populationSize);
+
+    void setInfectionProbability(float probability);
+    void setContactsPerDay(double contacts);
+    void setInfectionDuration(int days);
+
+    /**
+     * @brief Sets the prevalence thresholds that trigger a representation change
+     *
+     * @param switchAt I/N at which the aggregated engine takes over (0 < switchAt <= 1)
+     * @param returnBelow I/N below which agents are restored in the tail (0 <= returnBelow < switchAt)
+     * @throws std::invalid_argument if the thresholds are out of range
+     */
+    void setSwitchThresholds(double switchAt, double returnBelow);
+
+    void setSeed(unsigned int seed) override;
+    void reset(unsigned int seed) override;
+    void infectRandomPerson() override;
+    void infectRandomPeople(int count) override;
+
+    /**
+     * @brief Infects the listed agents
+     *
+     * @throws std::logic_error while the aggregated engine is active
+     * @throws std::out_of_range if an ID is out of range
+     */
+    void infectPeople(const std::vector<std::uint32_t>& ids) override;
+
+    /**
+     * @brief Vaccinates a batch of listed agents (see Population::vaccinatePeople())
+     *
+     * @throws std::logic_error while the aggregated engine is active
+     * @throws std::out_of_range if an ID is out of range
+     */
+    int vaccinatePeople(const std::uint32_t* ids, std::size_t count) override;
+
+    /**
+     * @brief Sets the infection probability and the contacts per day
+     *
+     * The agent phase draws floor(c) contacts per infected individual plus
+     * one more with probability frac(c); the aggregated phase uses c itself.
+     */
+    void setTransmissionParameters(float infectionProbability, double contactsPerDay) override;
+
+    void simulateOneDay() override;
+
+    int getCurrentDay() const override;
+    int getPopulationSize() const override { return agents.getPopulationSize(); }
+    int getSusceptibleCount() const override;
+    int getInfectedCount() const override;
+    int getRecoveredCount() const override;
+    std::int64_t getCumulativeInfections() const override;
+
+    bool isAggregated() const { return aggregated; }
+    int getSwitchCount() const { return switchCount; }
+};
+
+#endif // HYBRID_MODEL_H
@@ -0,0 +1,117 @@
+/**
+ * @file Intervention.cpp
+ * @brief Implementation of the vaccination campaign
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "Intervention.h"
+#include "Random.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+VaccinationCampaign::VaccinationCampaign(int populationSize, const std::vector<PriorityGroup>& groups,
+                                         int daily, int firstDay)
+    : dosesPerDay(daily), startDay(firstDay), cursor(0), vaccinated(0) {
+    if (populationSize <= 0 || dosesPerDay <= 0 || startDay < 0) {
+        throw std::invalid_argument("Vaccination needs a population, doses per day > 0 and start day >= 0");
+    }
+    std::size_t total = 0;
+    for (const PriorityGroup& group : groups) {
+        total += group.ids.size();
+    }
+    queue.reserve(total);
+    std::vector<bool> listed(static_cast<std::size_t>(populationSize), false);
+    for (const PriorityGroup& group : groups) {
+        for (std::uint32_t id : group.ids) {
+            if (id >= static_cast<std::uint32_t>(populationSize)) {
+                throw std::invalid_argument("Agent ID out of range in group " + group.name + ": " +
+                                            std::to_string(id));
+            }
+            if (listed[id]) {
+                throw std::invalid_argument("Agent " + std::to_string(id) + " is listed twice");
+            }
+            listed[id] = true;
+        }
+        queue.insert(queue.end(), group.ids.begin(), group.ids.end());
+        groupEnds.push_back(queue.size());
+        groupNames.push_back(group.name);
+    }
+}
+
+VaccinationCampaign VaccinationCampaign::randomOrder(int populationSize, std::uint64_t seed, int dosesPerDay,
+                                                     int startDay) {
+    PriorityGroup everyone;
+    everyone.name = "all";
+    everyone.ids.resize(static_cast<std::size_t>(std::max(populationSize, 0)));
+    std::iota(everyone.ids.begin(), everyone.ids.end(), 0u);
+    // Fisher-Yates
+    SplitMix64 rng(seed);
+    for (std::size_t i = everyone.ids.size(); i > 1; --i) {
+        std::swap(everyone.ids[i - 1], everyone.ids[boundedRandom(rng(), i)]);
+    }
+    return VaccinationCampaign(populationSize, {everyone}, dosesPerDay, startDay);
+}
+
+void VaccinationCampaign::apply(EpidemicModel& model) {
+    if (model.getCurrentDay() < startDay || isFinished()) {
+        return;
+    }
+    std::size_t doses = std::min(static_cast<std::size_t>(dosesPerDay), queue.size() - cursor);
+    vaccinated += model.vaccinatePeople(queue.data() + cursor, doses);
+    cursor += doses;
+}
+
+void VaccinationCampaign::reset() {
+    cursor = 0;
+    vaccinated = 0;
+}
+
+void VaccinationCampaign::setDosesPerDay(int doses) {
+    if (doses <= 0) {
+        throw std::invalid_argument("Doses per day must be positive");
+    }
+    dosesPerDay = doses;
+}
+
+int VaccinationCampaign::getCurrentGroup() const {
+    return static_cast<int>(std::upper_bound(groupEnds.begin(), groupEnds.end(), cursor) - groupEnds.begin());
+}
+
+std::size_t VaccinationCampaign::getGroupDosesGiven(int group) const {
+    std::size_t begin = group > 0 ? groupEnds[group - 1] : 0;
+    return std::min(std::max(cursor, begin), groupEnds[group]) - begin;
+}
+
+ParameterScheduler::ParameterScheduler(const ParameterSchedule& parameterSchedule,
+                                       const TransmissionParameters& baseValues)
+    : schedule(parameterSchedule), base(baseValues), current(baseValues), position(0), changeDay(0) {}
+
+void ParameterScheduler::apply(EpidemicModel& model) {
+    const int today = model.getCurrentDay();
+    if (today < changeDay) {
+        return;
+    }
+    // Days only move forward between resets, so the cursor advances incrementally
+    if (position > 0 && schedule.getKnot(position - 1).day > today) {
+        position = 0;
+    }
+    while (position < schedule.size() && schedule.getKnot(position).day <= today) {
+        position++;
+    }
+    current = schedule.valuesAt(today, base, position);
+    changeDay = schedule.nextChangeDay(today, position);
+    model.setTransmissionParameters(current.infectionProbability, current.contactsPerDay);
+}
+
+void ParameterScheduler::reset() {
+    seek(0);
+}
+
+void ParameterScheduler::seek(int day) {
+    position = schedule.positionAt(day);
+    current = schedule.valuesAt(day, base, position);
+    // apply() on this day recomputes the values and sends them
+    changeDay = day;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file Intervention.h
+ * @brief Daily interventions applied by the simulation driver (vaccination campaigns,
+ *        parameter schedules)
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the Intervention interface called by SIRSimulation before
+ * every simulated day, and the VaccinationCampaign that vaccinates a fixed
+ * number of agents per day in a precomputed priority order, and the
+ * ParameterScheduler that applies a ParameterSchedule.
+ */
+
+#ifndef INTERVENTION_H
+#define INTERVENTION_H
+
+#include "EpidemicModel.h"
+#include "ParameterSchedule.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Action taken on the engine at the start of each simulated day
+ */
+class Intervention {
+public:
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~Intervention() = default;
+
+    /**
+     * @brief Acts on the engine before it simulates the next day
+     *
+     * Called with the day-d state (model.getCurrentDay() == d) right before the
+     * engine advances to day d + 1, so changes take effect for that day.
+     *
+     * @param model Engine driven by the simulation
+     */
+    virtual void apply(EpidemicModel& model) = 0;
+
+    /**
+     * @brief Rewinds the intervention for a new replicate
+     */
+    virtual void reset() = 0;
+};
+
+/**
+ * @brief Named group of agents in vaccination priority order
+ */
+struct PriorityGroup {
+    std::string name;                   ///< Label used in reports (e.g. "80+")
+    std::vector<std::uint32_t> ids;     ///< Agent IDs, highest priority first
+};
+
+/**
+ * @brief Vaccinates a fixed number of agents per day in priority order
+ *
+ * The groups are concatenated once into a single dose queue (group offsets
+ * are kept for reporting) and a cursor walks it, so a day of the campaign is
+ * one EpidemicModel::vaccinatePeople() call on a contiguous slice: O(doses)
+ * work with no scan of the population. A day's doses run over into the next
+ * group when a group is finished. Every queued agent receives one dose
+ * whatever their state; only susceptible agents are moved.
+ */
+class VaccinationCampaign : public Intervention {
+private:
+    std::vector<std::uint32_t> queue;       ///< All groups back to back, in priority order
+    std::vector<std::size_t> groupEnds;     ///< End of each group in queue
+    std::vector<std::string> groupNames;    ///< Name of each group
+    int dosesPerDay;                        ///< Doses given per day
+    int startDay;                           ///< First day doses are given
+    std::size_t cursor;                     ///< Doses given so far (next queue position)
+    std::int64_t vaccinated;                ///< Agents moved out of the susceptible compartment
+
+public:
+    /**
+     * @brief Builds the dose queue from priority groups
+     *
+     * @param populationSize Number of agents (every ID must be below it)
+     * @param groups Groups in priority order
+     * @param dosesPerDay Doses given per day (> 0)
+     * @param startDay First day doses are given (>= 0)
+     * @throws std::invalid_argument if a parameter is out of range, an ID is
+     *         out of range or an agent is listed twice
+     */
+    VaccinationCampaign(int populationSize, const std::vector<PriorityGroup>& groups, int dosesPerDay,
+                        int startDay = 0);
+
+    /**
+     * @brief Campaign over the whole population in a uniformly random order
+     *
+     * @param populationSize Number of agents
+     * @param seed Seed of the shuffle
+     * @param dosesPerDay Doses given per day (> 0)
+     * @param startDay First day doses are given (>= 0)
+     */
+    static VaccinationCampaign randomOrder(int populationSize, std::uint64_t seed, int dosesPerDay,
+                                           int startDay = 0);
+
+    /**
+     * @brief Gives the day's doses (nothing before startDay or once the queue is used up)
+     */
+    void apply(EpidemicModel& model) override;
+
+    /**
+     * @brief Returns the cursor to the head of the queue
+     */
+    void reset() override;
+
+    /**
+     * @brief Changes the daily dose count from the next apply() on
+     *
+     * @throws std::invalid_argument unless doses > 0
+     */
+    void setDosesPerDay(int doses);
+
+    /**
+     * @brief Gets the group the next dose goes to (getGroupCount() when finished)
+     */
+    int getCurrentGroup() const;
+
+    /**
+     * @brief Gets the number of doses given to a group so far
+     */
+    std::size_t getGroupDosesGiven(int group) const;
+
+    std::size_t getDosesGiven() const { return cursor; }
+    std::size_t getDosesPlanned() const { return queue.size(); }
+    std::int64_t getVaccinatedCount() const { return vaccinated; }
+    int getDosesPerDay() const { return dosesPerDay; }
+    int getStartDay() const { return startDay; }
+    int getGroupCount() const { return static_cast<int>(groupNames.size()); }
+    const std::string& getGroupName(int group) const { return groupNames[group]; }
+    bool isFinished() const { return cursor == queue.size(); }
+};
+
+/**
+ * @brief Applies a ParameterSchedule to the engine's transmission parameters
+ *
+ * The scheduler keeps a cursor into the schedule (the number of knots
+ * reached) and the next day the values change, so a day without a change
+ * costs one comparison and the engine is only called on change days (every
+ * day of a linear ramp). The cursor is the schedule's whole resumable state:
+ * getPosition() and getNextChangeDay() can be recorded with a simulation
+ * state and seek() restores it for any day.
+ */
+class ParameterScheduler : public Intervention {
+private:
+    ParameterSchedule schedule;             ///< Knots
+    TransmissionParameters base;            ///< Values before the first knot
+    TransmissionParameters current;         ///< Values last sent to the engine
+    std::size_t position;                   ///< Knots reached (knot day <= current day)
+    int changeDay;                          ///< Next day the engine must be updated
+
+public:
+    /**
+     * @brief Attaches a schedule to the configured base values
+     *
+     * @param schedule Knots
+     * @param base Values before the first knot (the configured parameters)
+     */
+    ParameterScheduler(const ParameterSchedule& schedule, const TransmissionParameters& base);
+
+    /**
+     * @brief Sends the day's values to the engine on change days
+     */
+    void apply(EpidemicModel& model) override;
+
+    /**
+     * @brief Rewinds to day 0; the next apply() sends the day-0 values
+     */
+    void reset() override;
+
+    /**
+     * @brief Positions the cursor on a day (e.g. when resuming a saved state)
+     *
+     * Computes the day's values and the next change day; the next apply()
+     * on that day sends the values to the engine.
+     *
+     * @param day Simulation day (>= 0)
+     */
+    void seek(int day);
+
+    std::size_t getPosition() const { return position; }
+    int getNextChangeDay() const { return changeDay; }
+    const TransmissionParameters& getCurrentValues() const { return current; }
+    const ParameterSchedule& getSchedule() const { return schedule; }
+};
+
+#endif // INTERVENTION_H
@@ -0,0 +1,36 @@
+/**
+ * @file Main.cpp
+ * @brief Entry point of the SIR epidemic simulation
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "Simulation.h"
+#include <iostream>
+
+int main() {
+    try {
+        // Create simulation configuration with default parameters
+        SimulationConfig config;
+        
+        // Optionally customize parameters for different scenarios
+        // Example: config.populationSize = 5000;
+        // Example: config.infectionProbability = 0.3f;
+        // Example: config.engine = SimulationEngine::Gillespie;
+        // Example: config.seed = 42;
+        
+        std::cout << "Initializing simulation with configuration:" << std::endl;
+        std::cout << config.toString() << std::endl;
+        std::cout << std::endl;
+        
+        // Create and run simulation
+        SIRSimulation simulation(config);
+        simulation.runSimulation();
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
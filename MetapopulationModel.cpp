@@ -0,0 +1,394 @@
+/**
+ * @file MetapopulationModel.cpp
+ * @brief Implementation of the mobility matrix and the metapopulation engine
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "MetapopulationModel.h"
+#include "Parallel.h"
+#include "Person.h"
+#include "Sampling.h"
+#include "StateKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+// MobilityMatrix implementation
+MobilityMatrix::MobilityMatrix(std::uint32_t patches)
+    : patchCount(patches), offsets(static_cast<std::size_t>(patches) + 1, 0) {
+}
+
+MobilityMatrix::MobilityMatrix(std::uint32_t patches, const std::vector<MobilityFlow>& flows)
+    : MobilityMatrix(patches) {
+    for (const MobilityFlow& flow : flows) {
+        if (flow.source >= patches || flow.destination >= patches || !(flow.fraction >= 0.0)) {
+            throw std::invalid_argument("Mobility flow references an unknown patch or has a negative fraction");
+        }
+        if (flow.source != flow.destination) {
+            offsets[flow.source + 1]++;
+        }
+    }
+    for (std::uint32_t p = 0; p < patches; ++p) {
+        offsets[p + 1] += offsets[p];
+    }
+
+    destinations.resize(offsets.back());
+    cumulative.resize(offsets.back());
+    std::vector<std::uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (const MobilityFlow& flow : flows) {
+        if (flow.source != flow.destination) {
+            destinations[cursor[flow.source]] = flow.destination;
+            cumulative[cursor[flow.source]] = flow.fraction;
+            cursor[flow.source]++;
+        }
+    }
+    for (std::uint32_t p = 0; p < patches; ++p) {
+        double sum = 0.0;
+        for (std::uint64_t k = offsets[p]; k < offsets[p + 1]; ++k) {
+            sum += cumulative[k];
+            cumulative[k] = sum;
+        }
+        if (sum > 1.0 + 1e-9) {
+            throw std::invalid_argument("Mobility fractions of a patch sum above 1");
+        }
+    }
+}
+
+MobilityMatrix MobilityMatrix::grid(std::uint32_t patches, double fraction) {
+    if (fraction < 0.0 || fraction > 1.0) {
+        throw std::invalid_argument("Grid mobility fraction must be in [0, 1]");
+    }
+    const std::uint32_t columns = static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<double>(patches))));
+    std::vector<MobilityFlow> flows;
+    flows.reserve(static_cast<std::size_t>(patches) * 4);
+    std::vector<std::uint32_t> neighbors;
+    for (std::uint32_t p = 0; p < patches; ++p) {
+        std::uint32_t column = p % columns;
+        neighbors.clear();
+        if (p >= columns) {
+            neighbors.push_back(p - columns);
+        }
+        if (column > 0) {
+            neighbors.push_back(p - 1);
+        }
+        if (column + 1 < columns && p + 1 < patches) {
+            neighbors.push_back(p + 1);
+        }
+        if (p + columns < patches) {
+            neighbors.push_back(p + columns);
+        }
+        for (std::uint32_t neighbor : neighbors) {
+            MobilityFlow flow = {p, neighbor, fraction / neighbors.size()};
+            flows.push_back(flow);
+        }
+    }
+    return MobilityMatrix(patches, flows);
+}
+
+MobilityMatrix MobilityMatrix::loadFile(const std::string& path, std::uint32_t patches) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        throw std::runtime_error("Cannot open mobility file: " + path);
+    }
+    std::vector<MobilityFlow> flows;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        MobilityFlow flow;
+        if (!(fields >> flow.source >> flow.destination >> flow.fraction)) {
+            throw std::runtime_error("Malformed mobility line: " + line);
+        }
+        flows.push_back(flow);
+    }
+    return MobilityMatrix(patches, flows);
+}
+
+// MetapopulationModel implementation
+namespace {
+
+int totalPatchSize(const std::vector<int>& patchSizes) {
+    if (patchSizes.empty()) {
+        throw std::invalid_argument("A metapopulation needs at least one patch");
+    }
+    long long total = 0;
+    for (int patchSize : patchSizes) {
+        if (patchSize <= 0) {
+            throw std::invalid_argument("Every patch must contain at least one individual");
+        }
+        total += patchSize;
+        if (total > INT_MAX) {
+            throw std::invalid_argument("Metapopulation exceeds INT_MAX individuals");
+        }
+    }
+    return static_cast<int>(total);
+}
+
+/**
+ * @brief sampleSusceptible() draw source over the seeding SplitMix64 stream
+ */
+struct SplitMixDraws {
+    SplitMix64& rng;
+
+    std::uint32_t below(std::uint32_t range) { return static_cast<std::uint32_t>(boundedRandom(rng(), range)); }
+    double unit() { return unitInterval(rng()); }
+};
+
+} // namespace
+
+MetapopulationModel::MetapopulationModel(const std::vector<int>& patchSizes, const StorageOptions& storage)
+    : size(totalPatchSize(patchSizes)), day(0), countSusceptible(size), countInfected(0), countRecovered(0),
+      countImmunized(0), infectionProbability(0.0f), contactsPerDay(0.0), infectionDuration(0), threads(storage.threads),
+      patchOffsets(patchSizes.size() + 1, 0), agentSlab(2 * Arena::alignedSize(size), storage.pages),
+      states(agentSlab.allocate<std::uint8_t>(size)), daysLeft(agentSlab.allocate<std::uint8_t>(size)),
+      patchInfected(patchSizes.size(), 0), mobility(static_cast<std::uint32_t>(patchSizes.size())), seed(0) {
+    for (std::size_t p = 0; p < patchSizes.size(); ++p) {
+        patchOffsets[p + 1] = patchOffsets[p] + static_cast<std::uint32_t>(patchSizes[p]);
+    }
+    // First touch patch by patch, with the partition of the day loop
+    fillSusceptible();
+    setSeed(std::random_device{}());
+}
+
+void MetapopulationModel::fillSusceptible() {
+    StorageOptions fill;
+    fill.threads = threads;
+    parallelFor(patchOffsets.size() - 1, fill.touchThreads(size), [this](std::size_t begin, std::size_t end, int) {
+        std::fill(states + patchOffsets[begin], states + patchOffsets[end],
+                  static_cast<std::uint8_t>(HealthState::Susceptible));
+        std::fill(daysLeft + patchOffsets[begin], daysLeft + patchOffsets[end], 0);
+    });
+}
+
+std::vector<int> MetapopulationModel::evenPatchSizes(int populationSize, int patches) {
+    if (patches < 1 || patches > populationSize) {
+        throw std::invalid_argument("Patch count must be between 1 and the population size");
+    }
+    std::vector<int> sizes(patches, populationSize / patches);
+    for (int p = 0; p < populationSize % patches; ++p) {
+        sizes[p]++;
+    }
+    return sizes;
+}
+
+void MetapopulationModel::setSeed(unsigned int seedValue) {
+    seed = seedValue;
+    seedingRng.seed(streamSeed(seed, ~0ULL));
+}
+
+void MetapopulationModel::reset(unsigned int seedValue) {
+    fillSusceptible();
+    std::fill(patchInfected.begin(), patchInfected.end(), 0);
+    day = 0;
+    countSusceptible = size;
+    countInfected = 0;
+    countRecovered = 0;
+    countImmunized = 0;
+    setSeed(seedValue);
+}
+
+void MetapopulationModel::setInfectionProbability(float probability) {
+    infectionProbability = probability;
+}
+
+void MetapopulationModel::setContactsPerDay(double contacts) {
+    contactsPerDay = contacts;
+}
+
+void MetapopulationModel::setInfectionDuration(int days) {
+    if (days <= 0 || days > MAX_INFECTION_DURATION) {
+        throw std::invalid_argument("Infection duration must be between 1 and 255 days");
+    }
+    infectionDuration = days;
+}
+
+void MetapopulationModel::setMobility(const MobilityMatrix& matrix) {
+    if (matrix.getPatchCount() != static_cast<std::uint32_t>(getPatchCount())) {
+        throw std::invalid_argument("Mobility matrix must have one row per patch");
+    }
+    mobility = matrix;
+}
+
+std::uint32_t MetapopulationModel::patchOf(std::uint32_t index) const {
+    return static_cast<std::uint32_t>(std::upper_bound(patchOffsets.begin(), patchOffsets.end(), index) -
+                                      patchOffsets.begin() - 1);
+}
+
+void MetapopulationModel::infectAgent(std::uint32_t index) {
+    if (infectionDuration <= 0) {
+        throw std::invalid_argument("Infection duration must be positive");
+    }
+    if (states[index] == static_cast<std::uint8_t>(HealthState::Susceptible)) {
+        states[index] = static_cast<std::uint8_t>(HealthState::Infected);
+        daysLeft[index] = static_cast<std::uint8_t>(infectionDuration);
+        patchInfected[patchOf(index)]++;
+        countSusceptible--;
+        countInfected++;
+    }
+}
+
+void MetapopulationModel::infectRandomPerson() {
+    infectAgent(static_cast<std::uint32_t>(boundedRandom(seedingRng(), static_cast<std::uint64_t>(size))));
+}
+
+void MetapopulationModel::infectRandomPeople(int count) {
+    if (count < 0 || count > countSusceptible) {
+        throw std::invalid_argument("Cannot infect more people than are susceptible");
+    }
+    SplitMixDraws draws = {seedingRng};
+    sampleSusceptible(states, size, countSusceptible, count, draws,
+                      [this](std::uint32_t index) { infectAgent(index); });
+}
+
+void MetapopulationModel::infectPeople(const std::vector<std::uint32_t>& ids) {
+    // Validate the whole list first, so a bad ID leaves the model untouched
+    auto invalid = std::find_if(ids.begin(), ids.end(), [this](std::uint32_t id) {
+        return id >= static_cast<std::uint32_t>(size);
+    });
+    if (invalid != ids.end()) {
+        throw std::out_of_range("Agent ID out of range: " + std::to_string(*invalid));
+    }
+    for (std::uint32_t id : ids) {
+        infectAgent(id);
+    }
+}
+
+int MetapopulationModel::vaccinatePeople(const std::uint32_t* ids, std::size_t count) {
+    const std::uint32_t* invalid = std::find_if(ids, ids + count, [this](std::uint32_t id) {
+        return id >= static_cast<std::uint32_t>(size);
+    });
+    if (invalid != ids + count) {
+        throw std::out_of_range("Agent ID out of range: " + std::to_string(*invalid));
+    }
+    const std::uint8_t susceptible = static_cast<std::uint8_t>(HealthState::Susceptible);
+    const std::uint8_t recovered = static_cast<std::uint8_t>(HealthState::Recovered);
+    std::atomic<int> vaccinated(0);
+    parallelFor(count, count < MIN_PARALLEL_BATCH ? 1 : threads, [&](std::size_t begin, std::size_t end, int) {
+        // Scattered agents: prefetch ahead so the cache misses overlap
+        const std::size_t distance = 16;
+        int moved = 0;
+        for (std::size_t k = begin; k < end; ++k) {
+            if (k + distance < end) {
+                __builtin_prefetch(states + ids[k + distance], 1);
+            }
+            if (states[ids[k]] == susceptible) {
+                states[ids[k]] = recovered;
+                moved++;
+            }
+        }
+        vaccinated += moved;
+    });
+    countSusceptible -= vaccinated;
+    countRecovered += vaccinated;
+    countImmunized += vaccinated;
+    return vaccinated;
+}
+
+void MetapopulationModel::infectRandomPersonInPatch(int patch) {
+    if (patch < 0 || patch >= getPatchCount()) {
+        throw std::invalid_argument("Patch index out of range");
+    }
+    infectAgent(patchOffsets[patch] +
+                static_cast<std::uint32_t>(boundedRandom(seedingRng(), static_cast<std::uint64_t>(getPatchSize(patch)))));
+}
+
+void MetapopulationModel::setTransmissionParameters(float probability, double contacts) {
+    setInfectionProbability(probability);
+    setContactsPerDay(contacts);
+}
+
+void MetapopulationModel::simulateOneDay() {
+    const std::size_t patches = static_cast<std::size_t>(getPatchCount());
+    // Same partition as parallelFor(patches, threads, ...)
+    const int partitions = static_cast<int>(std::min<std::size_t>(resolveThreadCount(threads), patches));
+    std::vector<std::uint32_t> partitionFirstPatch(partitions + 1);
+    for (int t = 0; t <= partitions; ++t) {
+        partitionFirstPatch[t] = static_cast<std::uint32_t>(patches * t / partitions);
+    }
+    outboxes.resize(static_cast<std::size_t>(partitions) * partitions);
+
+    const std::uint64_t dayStream = streamSeed(seed, static_cast<std::uint64_t>(day));
+    const std::uint8_t susceptible = static_cast<std::uint8_t>(HealthState::Susceptible);
+    const std::uint8_t infected = static_cast<std::uint8_t>(HealthState::Infected);
+    // A fractional mean is one extra contact with that probability
+    const int wholeContacts = static_cast<int>(contactsPerDay);
+    const double extraContact = contactsPerDay - wholeContacts;
+
+    // Pass 1: transmission from start-of-day states into the outboxes
+    parallelFor(patches, threads, [&](std::size_t begin, std::size_t end, int thread) {
+        std::vector<std::uint32_t>* outbox = outboxes.data() + static_cast<std::size_t>(thread) * partitions;
+        for (std::size_t p = begin; p < end; ++p) {
+            if (patchInfected[p] == 0) {
+                continue;
+            }
+            SplitMix64 rng(streamSeed(dayStream, p));
+            for (std::uint32_t i = patchOffsets[p]; i < patchOffsets[p + 1]; ++i) {
+                if (states[i] != infected) {
+                    continue;
+                }
+                const int contacts = wholeContacts + (extraContact > 0.0 && unitInterval(rng()) < extraContact);
+                for (int c = 0; c < contacts; ++c) {
+                    std::uint32_t destination = mobility.sampleDestination(static_cast<std::uint32_t>(p),
+                                                                           unitInterval(rng()));
+                    std::uint32_t first = patchOffsets[destination];
+                    std::uint32_t contact = first + static_cast<std::uint32_t>(
+                        boundedRandom(rng(), patchOffsets[destination + 1] - first));
+                    if (states[contact] == susceptible && unitInterval(rng()) <= infectionProbability) {
+                        int owner = static_cast<int>(std::upper_bound(partitionFirstPatch.begin() + 1,
+                                                                      partitionFirstPatch.end(), destination) -
+                                                     partitionFirstPatch.begin() - 1);
+                        outbox[owner].push_back(contact);
+                    }
+                }
+            }
+        }
+    });
+
+    // Pass 2: progression and counting per patch, then each thread applies its inbox
+    std::vector<StateCounts> partitionCounts(partitions, StateCounts());
+    parallelFor(patches, threads, [&](std::size_t begin, std::size_t end, int thread) {
+        StateCounts& counts = partitionCounts[thread];
+        for (std::size_t p = begin; p < end; ++p) {
+            std::uint32_t first = patchOffsets[p];
+            StateCounts patchCounts = progressAndCountStates(states + first, daysLeft + first,
+                                                             patchOffsets[p + 1] - first);
+            patchInfected[p] = static_cast<int>(patchCounts.infected);
+            counts.susceptible += patchCounts.susceptible;
+            counts.infected += patchCounts.infected;
+            counts.recovered += patchCounts.recovered;
+        }
+        for (int source = 0; source < partitions; ++source) {
+            std::vector<std::uint32_t>& inbox = outboxes[static_cast<std::size_t>(source) * partitions + thread];
+            for (std::uint32_t index : inbox) {
+                if (states[index] == susceptible) {
+                    states[index] = infected;
+                    daysLeft[index] = static_cast<std::uint8_t>(infectionDuration);
+                    patchInfected[patchOf(index)]++;
+                    counts.susceptible--;
+                    counts.infected++;
+                }
+            }
+            inbox.clear();
+        }
+    });
+
+    StateCounts total = StateCounts();
+    for (const StateCounts& counts : partitionCounts) {
+        total.susceptible += counts.susceptible;
+        total.infected += counts.infected;
+        total.recovered += counts.recovered;
+    }
+    countSusceptible = static_cast<int>(total.susceptible);
+    countInfected = static_cast<int>(total.infected);
+    countRecovered = static_cast<int>(total.recovered);
+    day++;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file MetapopulationModel.h
+ * @brief Patch-structured agent engine with sparse inter-patch mobility
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the MobilityMatrix class, a CSR matrix of contact fractions
+ * between patches, and the MetapopulationModel class, which partitions the
+ * agents into patches with homogeneous mixing inside each patch.
+ */
+
+#ifndef METAPOPULATION_MODEL_H
+#define METAPOPULATION_MODEL_H
+
+#include "Arena.h"
+#include "EpidemicModel.h"
+#include "Random.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One sparse entry of a mobility matrix
+ */
+struct MobilityFlow {
+    std::uint32_t source;        ///< Patch of the infected individual
+    std::uint32_t destination;   ///< Patch in which the contact takes place
+    double fraction;             ///< Fraction of the source's contacts made in the destination
+};
+
+/**
+ * @brief Sparse inter-patch mobility in CSR form
+ *
+ * Row p lists the patches that residents of p visit with the fraction of their
+ * daily contacts made there; the remaining 1 - sum(row) stay in p. Each row
+ * stores cumulative fractions, so drawing a contact's patch is a short scan
+ * over a handful of entries.
+ */
+class MobilityMatrix {
+private:
+    std::uint32_t patchCount;               ///< Number of patches
+    std::vector<std::uint64_t> offsets;     ///< Row p spans [offsets[p], offsets[p + 1])
+    std::vector<std::uint32_t> destinations;   ///< Destination patch of each entry
+    std::vector<double> cumulative;         ///< Running sum of fractions within each row
+
+public:
+    /**
+     * @brief Constructs a matrix without mobility (every contact stays home)
+     *
+     * @param patches Number of patches
+     */
+    explicit MobilityMatrix(std::uint32_t patches = 1);
+
+    /**
+     * @brief Constructs a matrix from sparse entries
+     *
+     * Entries may appear in any order; self-flows are ignored.
+     *
+     * @param patches Number of patches
+     * @param flows Sparse entries
+     * @throws std::invalid_argument for out-of-range patches, negative fractions
+     *         or rows whose fractions sum above 1
+     */
+    MobilityMatrix(std::uint32_t patches, const std::vector<MobilityFlow>& flows);
+
+    /**
+     * @brief Builds nearest-neighbor mobility on a rectangular grid
+     *
+     * Patches are laid out row-major with ceil(sqrt(patches)) columns; each
+     * patch makes `fraction` of its contacts in its (up to four) grid
+     * neighbors, split evenly.
+     *
+     * @param patches Number of patches
+     * @param fraction Fraction of contacts made outside the home patch (0..1)
+     * @return Grid mobility matrix
+     */
+    static MobilityMatrix grid(std::uint32_t patches, double fraction);
+
+    /**
+     * @brief Loads a matrix from a text file of "source destination fraction" lines
+     *
+     * Blank lines and lines starting with '#' are skipped.
+     *
+     * @param path File to read
+     * @param patches Number of patches
+     * @return Mobility matrix
+     * @throws std::runtime_error if the file cannot be read or parsed
+     * @throws std::invalid_argument if an entry is invalid
+     */
+    static MobilityMatrix loadFile(const std::string& path, std::uint32_t patches);
+
+    /**
+     * @brief Draws the patch in which a contact of a source-patch resident takes place
+     *
+     * @param source Home patch
+     * @param u Uniform variate in [0, 1)
+     * @return Destination patch (source itself with probability 1 - sum(row))
+     */
+    std::uint32_t sampleDestination(std::uint32_t source, double u) const {
+        for (std::uint64_t k = offsets[source]; k < offsets[source + 1]; ++k) {
+            if (u < cumulative[k]) {
+                return destinations[k];
+            }
+        }
+        return source;
+    }
+
+    std::uint32_t getPatchCount() const { return patchCount; }
+    std::uint64_t getFlowCount() const { return destinations.size(); }
+};
+
+/**
+ * @brief Agent-based SIR engine on a metapopulation of patches
+ *
+ * Agents are stored as byte-per-agent state arrays (as in Population) with each
+ * patch occupying a contiguous index range. Every infected individual makes
+ * contactsPerDay contacts; each contact takes place in a patch drawn from its
+ * home patch's mobility row and picks a uniformly random member of that patch.
+ *
+ * Days run in two parallel passes over a static partition of the patches:
+ * - Transmission: each patch draws from its own stream derived from
+ *   (seed, day, patch), and reads only start-of-day states. Infections are
+ *   routed into per-thread outboxes keyed by the thread owning the target.
+ * - Update: each thread progresses and counts its patches with the state
+ *   kernels, then applies its inbox.
+ *
+ * Infection is idempotent, so the trajectory is identical for any thread count.
+ */
+class MetapopulationModel : public EpidemicModel {
+private:
+    int size;                               ///< Total population size
+    int day;                                ///< Current simulation day
+    int countSusceptible;                   ///< Number of susceptible individuals
+    int countInfected;                      ///< Number of infected individuals
+    int countRecovered;                     ///< Number of recovered individuals
+    std::int64_t countImmunized;            ///< Susceptibles moved to recovered by vaccination
+
+    float infectionProbability;             ///< Probability of infection upon contact
+    double contactsPerDay;                  ///< Mean contacts per infected person per day
+    int infectionDuration;                  ///< Duration of infection in days
+    int threads;                            ///< Requested worker threads (<= 0 = hardware)
+
+    std::vector<std::uint32_t> patchOffsets;   ///< Patch p owns agents [patchOffsets[p], patchOffsets[p + 1])
+    Arena agentSlab;                        ///< Single allocation holding the per-agent columns
+    std::uint8_t* states;                   ///< HealthState code of each individual (in agentSlab)
+    std::uint8_t* daysLeft;                 ///< Remaining infectious days of each individual (in agentSlab)
+    std::vector<int> patchInfected;         ///< Infected count of each patch
+    MobilityMatrix mobility;                ///< Inter-patch contact fractions
+
+    std::uint64_t seed;                     ///< Base seed of the per-patch streams
+    SplitMix64 seedingRng;                  ///< Generator for infectRandomPerson()
+    std::vector<std::vector<std::uint32_t>> outboxes;  ///< Infection buffers, [source thread][target thread]
+
+    /**
+     * @brief Infects one agent if susceptible, updating the patch and total counts
+     *
+     * @param index Agent index
+     */
+    void infectAgent(std::uint32_t index);
+
+    /**
+     * @brief Gets the patch owning an agent
+     */
+    std::uint32_t patchOf(std::uint32_t index) const;
+
+    /**
+     * @brief Sets every agent susceptible, patch by patch with the day-loop partition
+     */
+    void fillSusceptible();
+
+public:
+    /**
+     * @brief Constructor with patches of the given sizes
+     *
+     * The agent columns are first touched patch by patch with the partition
+     * of the day loop, so storage.threads also becomes the initial thread count.
+     * 
+     * @param patchSizes Number of agents in each patch (each > 0)
+     * @param storage Page backing and first-touch threads of the agent columns
+     * @throws std::invalid_argument if no patch is given, a patch is empty or
+     *         the total exceeds INT_MAX
+     */
+    explicit MetapopulationModel(const std::vector<int>& patchSizes, const StorageOptions& storage = StorageOptions());
+
+    /**
+     * @brief Splits a population evenly into patches
+     *
+     * @param populationSize Total number of agents
+     * @param patches Number of patches (1..populationSize)
+     * @return Patch sizes differing by at most one
+     * @throws std::invalid_argument if the patch count is out of range
+     */
+    static std::vector<int> evenPatchSizes(int populationSize, int patches);
+
+    void setSeed(unsigned int seedValue) override;
+    void reset(unsigned int seedValue) override;
+    void infectRandomPerson() override;
+
+    /**
+     * @brief Infects exactly count distinct susceptible agents (see Population::infectRandomPeople())
+     *
+     * @throws std::invalid_argument if count is negative or exceeds the susceptible count
+     */
+    void infectRandomPeople(int count) override;
+
+    /**
+     * @brief Infects the listed agents (IDs are patch-major agent indices)
+     *
+     * @throws std::out_of_range if an ID is out of range (before anyone is infected)
+     */
+    void infectPeople(const std::vector<std::uint32_t>& ids) override;
+
+    /**
+     * @brief Moves the susceptible agents of a dose batch to recovered
+     *
+     * Batches of at least MIN_PARALLEL_BATCH doses are split over the worker
+     * threads; the IDs must be distinct.
+     *
+     * @return Number of agents vaccinated
+     * @throws std::out_of_range if an ID is out of range (before any agent is changed)
+     */
+    int vaccinatePeople(const std::uint32_t* ids, std::size_t count) override;
+
+    /**
+     * @brief Sets the infection probability and the contacts per day
+     *
+     * Each infected agent draws floor(c) contacts plus one more with
+     * probability frac(c), so fractional values are kept as a mean.
+     */
+    void setTransmissionParameters(float infectionProbability, double contactsPerDay) override;
+
+    void simulateOneDay() override;
+
+    /**
+     * @brief Infects one uniformly chosen member of a patch
+     *
+     * @param patch Patch index
+     */
+    void infectRandomPersonInPatch(int patch);
+
+    void setInfectionProbability(float probability);
+    void setContactsPerDay(double contacts);
+
+    /**
+     * @brief Sets the duration of infection in days
+     *
+     * @param days Duration in days (1..MAX_INFECTION_DURATION)
+     * @throws std::invalid_argument if days is out of range
+     */
+    void setInfectionDuration(int days);
+
+    /**
+     * @brief Replaces the inter-patch mobility
+     *
+     * @param matrix Mobility matrix
+     * @throws std::invalid_argument if its patch count differs
+     */
+    void setMobility(const MobilityMatrix& matrix);
+
+    /**
+     * @brief Sets the number of worker threads
+     *
+     * @param count Threads (<= 0 selects the hardware concurrency)
+     */
+    void setThreadCount(int count) { threads = count; }
+
+    int getCurrentDay() const override { return day; }
+    int getPopulationSize() const override { return size; }
+    int getSusceptibleCount() const override { return countSusceptible; }
+    int getInfectedCount() const override { return countInfected; }
+    int getRecoveredCount() const override { return countRecovered; }
+    std::int64_t getCumulativeInfections() const override {
+        return static_cast<std::int64_t>(size) - countSusceptible - countImmunized;
+    }
+
+    int getPatchCount() const { return static_cast<int>(patchOffsets.size()) - 1; }
+    int getPatchSize(int patch) const { return static_cast<int>(patchOffsets[patch + 1] - patchOffsets[patch]); }
+    int getPatchInfectedCount(int patch) const { return patchInfected[patch]; }
+    const MobilityMatrix& getMobility() const { return mobility; }
+    PagePolicy getPagePolicy() const { return agentSlab.getPagePolicy(); }
+};
+
+#endif // METAPOPULATION_MODEL_H
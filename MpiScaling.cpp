@@ -0,0 +1,115 @@
+/**
+ * @file MpiScaling.cpp
+ * @brief Strong/weak scaling driver for the MPI-distributed population
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * Build with `make mpi`, then run for example
+ *
+ *     mpirun -np 4 ./sir_mpi_scaling strong 100000000 30
+ *     mpirun -np 4 ./sir_mpi_scaling weak 25000000 30
+ *
+ * In strong mode the global population is fixed; in weak mode it is the given
+ * number of agents per rank. The trajectory checksum printed at the end only
+ * depends on the seed and parameters, so it must agree across rank counts
+ * (`make mpi-check` compares 1 and 3 ranks).
+ */
+
+#include "DistributedPopulation.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Folds one day of global counts into a running FNV-1a style checksum
+ */
+std::uint64_t foldCounts(std::uint64_t hash, const DistributedPopulation& population) {
+    const std::int64_t values[3] = {population.getSusceptibleCount(), population.getInfectedCount(),
+                                    population.getRecoveredCount()};
+    for (std::int64_t value : values) {
+        hash = (hash ^ static_cast<std::uint64_t>(value)) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+int runScaling(int argc, char* argv[]) {
+    int rankCount = 1;
+    int rank = 0;
+    MPI_Comm_size(MPI_COMM_WORLD, &rankCount);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    const bool weak = argc > 1 && std::strcmp(argv[1], "weak") == 0;
+    if (argc > 1 && !weak && std::strcmp(argv[1], "strong") != 0) {
+        if (rank == 0) {
+            std::cerr << "Usage: " << argv[0] << " [strong|weak] [agents] [days]" << std::endl;
+        }
+        return 1;
+    }
+    const long long agents = argc > 2 ? std::atoll(argv[2]) : 10000000LL;
+    const int days = argc > 3 ? std::atoi(argv[3]) : 30;
+    const long long populationSize = weak ? agents * rankCount : agents;
+    if (agents <= 0 || days <= 0 || populationSize > 2147483647LL) {
+        if (rank == 0) {
+            std::cerr << "Population must be in 1..2^31-1 and days positive" << std::endl;
+        }
+        return 1;
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    MPI_Barrier(MPI_COMM_WORLD);
+    Clock::time_point start = Clock::now();
+    DistributedPopulation population(static_cast<int>(populationSize));
+    population.setInfectionProbability(0.05f);
+    population.setContactsPerDay(6);
+    population.setInfectionDuration(5);
+    population.setSeed(2025);
+    population.infectRandomPeople(100);
+    MPI_Barrier(MPI_COMM_WORLD);
+    double setupSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::uint64_t checksum = 0xCBF29CE484222325ULL;
+    start = Clock::now();
+    for (int d = 0; d < days; ++d) {
+        population.simulateOneDay();
+        checksum = foldCounts(checksum, population);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    unsigned long long attempts = population.getExchangedAttempts();
+    unsigned long long totalAttempts = 0;
+    MPI_Reduce(&attempts, &totalAttempts, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        std::cout << std::fixed << std::setprecision(2) << (weak ? "weak" : "strong") << " ranks "
+                  << rankCount << "  N " << populationSize << "  setup " << setupSeconds << " s  " << days
+                  << " days " << seconds << " s (" << 1e3 * seconds / days << " ms/day, "
+                  << std::setprecision(1) << static_cast<double>(populationSize) * days / seconds / 1e6
+                  << " M agent-days/s)  cross-rank attempts " << totalAttempts << std::endl;
+        std::cout << "checksum " << std::hex << checksum << std::dec << "  S " << population.getSusceptibleCount()
+                  << "  I " << population.getInfectedCount() << "  R " << population.getRecoveredCount()
+                  << std::endl;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int status = 1;
+    try {
+        status = runScaling(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_Finalize();
+    return status;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file NetworkGenerator.cpp
+ * @brief Implementation of the parallel synthetic network generators
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "NetworkGenerator.h"
+#include "Parallel.h"
+#include "Random.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Resolves the target node of Barabasi-Albert edge e (copy model)
+ *
+ * Slot 2e holds the source of edge e (node e / m) and slot 2e + 1 its target.
+ * The target copies a uniformly chosen earlier slot, which selects nodes with
+ * probability proportional to their degree. Copying a target slot recurses
+ * into an earlier edge; the expected depth is constant.
+ */
+std::uint32_t barabasiAlbertTarget(std::uint64_t edge, std::uint64_t edgesPerNode, std::uint64_t seed) {
+    std::uint64_t slot = 2 * edge + 1;
+    while (true) {
+        std::uint64_t earlierSlots = slot - 1;
+        if (earlierSlots == 0) {
+            return 0;
+        }
+        std::uint64_t chosen = boundedRandom(streamSeed(seed, slot), earlierSlots);
+        if (chosen % 2 == 0) {
+            return static_cast<std::uint32_t>((chosen / 2) / edgesPerNode);
+        }
+        slot = chosen;
+    }
+}
+
+} // namespace
+
+NetworkGenerator::NetworkGenerator(const NetworkSpec& networkSpec) : spec(networkSpec) {
+    if (spec.nodes < 2) {
+        throw std::invalid_argument("Synthetic networks need at least two nodes");
+    }
+    if (spec.meanDegree <= 0.0 || spec.meanDegree > spec.nodes - 1) {
+        throw std::invalid_argument("Mean degree must be in (0, nodes - 1]");
+    }
+    if (spec.model == NetworkModel::WattsStrogatz &&
+        (spec.meanDegree < 2.0 || spec.rewiringProbability < 0.0 || spec.rewiringProbability > 1.0)) {
+        throw std::invalid_argument("Watts-Strogatz needs mean degree >= 2 and rewiring probability in [0, 1]");
+    }
+}
+
+template <typename Visitor>
+void NetworkGenerator::forEachEdgeInBlock(std::uint64_t block, Visitor visit) const {
+    const std::uint32_t n = spec.nodes;
+    const std::uint32_t first = static_cast<std::uint32_t>(block * BLOCK_NODES);
+    const std::uint32_t last = static_cast<std::uint32_t>(std::min<std::uint64_t>(n, first + BLOCK_NODES));
+    SplitMix64 rng(streamSeed(spec.seed, block));
+
+    switch (spec.model) {
+        case NetworkModel::ErdosRenyi: {
+            // Geometric skipping over the candidates v > u
+            const double p = std::min(1.0, spec.meanDegree / (n - 1.0));
+            const double logMiss = std::log1p(-p);
+            for (std::uint32_t u = first; u < last; ++u) {
+                double v = u;
+                while (true) {
+                    double skip = p >= 1.0 ? 0.0 : std::floor(std::log1p(-unitInterval(rng())) / logMiss);
+                    v += 1.0 + skip;
+                    if (v >= n) {
+                        break;
+                    }
+                    visit(u, static_cast<std::uint32_t>(v));
+                }
+            }
+            break;
+        }
+        case NetworkModel::BarabasiAlbert: {
+            const std::uint64_t edgesPerNode = std::max<long>(1, std::lround(spec.meanDegree / 2.0));
+            for (std::uint32_t u = first; u < last; ++u) {
+                for (std::uint64_t k = 0; k < edgesPerNode; ++k) {
+                    visit(u, barabasiAlbertTarget(u * edgesPerNode + k, edgesPerNode, spec.seed));
+                }
+            }
+            break;
+        }
+        case NetworkModel::WattsStrogatz: {
+            const std::uint32_t half = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(spec.meanDegree / 2.0));
+            for (std::uint32_t u = first; u < last; ++u) {
+                for (std::uint32_t j = 1; j <= half; ++j) {
+                    std::uint32_t v = static_cast<std::uint32_t>((static_cast<std::uint64_t>(u) + j) % n);
+                    if (unitInterval(rng()) < spec.rewiringProbability) {
+                        do {
+                            v = static_cast<std::uint32_t>(boundedRandom(rng(), n));
+                        } while (v == u);
+                    }
+                    visit(u, v);
+                }
+            }
+            break;
+        }
+    }
+}
+
+ContactNetwork NetworkGenerator::build(int threads) const {
+    const std::uint32_t n = spec.nodes;
+    const std::uint64_t blocks = getBlockCount();
+    std::unique_ptr<std::atomic<std::uint64_t>[]> cursor(new std::atomic<std::uint64_t>[n]);
+    parallelFor(n, threads, [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t i = begin; i < end; ++i) {
+            cursor[i].store(0, std::memory_order_relaxed);
+        }
+    });
+
+    // Pass 1: degrees
+    parallelFor(blocks, threads, [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t block = begin; block < end; ++block) {
+            forEachEdgeInBlock(block, [&](std::uint32_t u, std::uint32_t v) {
+                if (u != v) {
+                    cursor[u].fetch_add(1, std::memory_order_relaxed);
+                    cursor[v].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+    });
+
+    std::vector<std::uint64_t> offsets(static_cast<std::size_t>(n) + 1, 0);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        std::uint64_t degree = cursor[i].load(std::memory_order_relaxed);
+        cursor[i].store(offsets[i], std::memory_order_relaxed);
+        offsets[i + 1] = offsets[i] + degree;
+    }
+
+    // Pass 2: regenerate the same edges and scatter both directions
+    std::vector<std::uint32_t> neighbors(offsets.back());
+    parallelFor(blocks, threads, [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t block = begin; block < end; ++block) {
+            forEachEdgeInBlock(block, [&](std::uint32_t u, std::uint32_t v) {
+                if (u != v) {
+                    neighbors[cursor[u].fetch_add(1, std::memory_order_relaxed)] = v;
+                    neighbors[cursor[v].fetch_add(1, std::memory_order_relaxed)] = u;
+                }
+            });
+        }
+    });
+
+    // Pass 3: sort each range (fixes the scatter order) and drop multi-edges
+    std::atomic<std::uint64_t> duplicates(0);
+    parallelFor(n, threads, [&](std::size_t begin, std::size_t end, int) {
+        std::uint64_t removed = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            std::uint32_t* first = neighbors.data() + offsets[i];
+            std::uint32_t* last = neighbors.data() + offsets[i + 1];
+            std::sort(first, last);
+            std::uint32_t* uniqueEnd = std::unique(first, last);
+            cursor[i].store(static_cast<std::uint64_t>(uniqueEnd - first), std::memory_order_relaxed);
+            removed += static_cast<std::uint64_t>(last - uniqueEnd);
+        }
+        duplicates.fetch_add(removed, std::memory_order_relaxed);
+    });
+    if (duplicates.load() == 0) {
+        return ContactNetwork(std::move(offsets), std::move(neighbors));
+    }
+
+    std::vector<std::uint64_t> compactOffsets(offsets.size(), 0);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        compactOffsets[i + 1] = compactOffsets[i] + cursor[i].load(std::memory_order_relaxed);
+    }
+    std::vector<std::uint32_t> compactNeighbors(compactOffsets.back());
+    parallelFor(n, threads, [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t i = begin; i < end; ++i) {
+            std::copy(neighbors.begin() + offsets[i],
+                      neighbors.begin() + offsets[i] + (compactOffsets[i + 1] - compactOffsets[i]),
+                      compactNeighbors.begin() + compactOffsets[i]);
+        }
+    });
+    return ContactNetwork(std::move(compactOffsets), std::move(compactNeighbors));
+}
+
+std::uint64_t NetworkGenerator::writeEdgeList(const std::string& path, int threads) const {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open edge list for writing: " + path);
+    }
+
+    const std::uint64_t blocks = getBlockCount();
+    const std::size_t batch = static_cast<std::size_t>(resolveThreadCount(threads)) * 4;
+    std::vector<std::vector<std::uint32_t>> buffers(batch);
+    std::uint64_t written = 0;
+    for (std::uint64_t firstBlock = 0; firstBlock < blocks; firstBlock += batch) {
+        std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(batch, blocks - firstBlock));
+        parallelFor(count, threads, [&](std::size_t begin, std::size_t end, int) {
+            for (std::size_t k = begin; k < end; ++k) {
+                std::vector<std::uint32_t>& buffer = buffers[k];
+                buffer.clear();
+                forEachEdgeInBlock(firstBlock + k, [&](std::uint32_t u, std::uint32_t v) {
+                    if (u != v) {
+                        buffer.push_back(u);
+                        buffer.push_back(v);
+                    }
+                });
+            }
+        });
+        for (std::size_t k = 0; k < count; ++k) {
+            out.write(reinterpret_cast<const char*>(buffers[k].data()),
+                      static_cast<std::streamsize>(buffers[k].size() * sizeof(std::uint32_t)));
+            written += buffers[k].size() / 2;
+        }
+        if (!out) {
+            throw std::runtime_error("Failed writing edge list: " + path);
+        }
+    }
+    return written;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file OdeModel.cpp
+ * @brief Implementation of the Dormand-Prince SIR solvers
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "OdeModel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+const double DEFAULT_RELATIVE_TOLERANCE = 1e-6;
+const double DEFAULT_ABSOLUTE_TOLERANCE = 1e-9;
+const double INITIAL_STEP = 0.1;
+
+// Dormand-Prince 5(4) tableau
+const double A21 = 1.0 / 5.0;
+const double A31 = 3.0 / 40.0, A32 = 9.0 / 40.0;
+const double A41 = 44.0 / 45.0, A42 = -56.0 / 15.0, A43 = 32.0 / 9.0;
+const double A51 = 19372.0 / 6561.0, A52 = -25360.0 / 2187.0, A53 = 64448.0 / 6561.0,
+             A54 = -212.0 / 729.0;
+const double A61 = 9017.0 / 3168.0, A62 = -355.0 / 33.0, A63 = 46732.0 / 5247.0,
+             A64 = 49.0 / 176.0, A65 = -5103.0 / 18656.0;
+const double B1 = 35.0 / 384.0, B3 = 500.0 / 1113.0, B4 = 125.0 / 192.0,
+             B5 = -2187.0 / 6784.0, B6 = 11.0 / 84.0;
+// Difference between the 5th and embedded 4th order weights
+const double E1 = 71.0 / 57600.0, E3 = -71.0 / 16695.0, E4 = 71.0 / 1920.0,
+             E5 = -17253.0 / 339200.0, E6 = 22.0 / 525.0, E7 = -1.0 / 40.0;
+
+/**
+ * @brief Integration state of W independent SIR systems, one per lane
+ *
+ * Only s and i are integrated; r = 1 - s - i.
+ */
+template <int W>
+struct OdeLanes {
+    double s[W], i[W];          ///< Current state
+    double ds[W], di[W];        ///< Derivative at the current state (FSAL stage)
+    double t[W], h[W], tEnd[W]; ///< Time, proposed step size and target time
+    double beta[W], gamma[W];   ///< Rates
+    double peakI[W], peakT[W];  ///< Running maximum of i and its time
+    int steps[W];               ///< Accepted steps
+};
+
+inline void sirDerivative(double beta, double gamma, double s, double i, double& ds, double& di) {
+    double incidence = beta * s * i;
+    ds = -incidence;
+    di = incidence - gamma * i;
+}
+
+template <int W>
+void initializeLane(OdeLanes<W>& lanes, int l, double beta, double gamma,
+                    double s, double i, double t, double tEnd) {
+    lanes.s[l] = s;
+    lanes.i[l] = i;
+    lanes.t[l] = t;
+    lanes.h[l] = INITIAL_STEP;
+    lanes.tEnd[l] = tEnd;
+    lanes.beta[l] = beta;
+    lanes.gamma[l] = gamma;
+    lanes.peakI[l] = i;
+    lanes.peakT[l] = t;
+    lanes.steps[l] = 0;
+    sirDerivative(beta, gamma, s, i, lanes.ds[l], lanes.di[l]);
+}
+
+/**
+ * @brief Attempts one Dormand-Prince step on every unfinished lane
+ *
+ * Each stage is a separate loop over the lanes so the compiler can vectorize it;
+ * acceptance, completion and peak tracking use selects instead of branches.
+ *
+ * @return Number of lanes that had not yet reached their target time
+ */
+template <int W>
+int dormandPrinceAttempt(OdeLanes<W>& L, double rtol, double atol) {
+    double hs[W];
+    double s2[W], i2[W], s3[W], i3[W], s4[W], i4[W], s5[W], i5[W], s6[W], i6[W], s7[W], i7[W];
+    double k2s[W], k2i[W], k3s[W], k3i[W], k4s[W], k4i[W], k5s[W], k5i[W], k6s[W], k6i[W],
+           k7s[W], k7i[W];
+    int active = 0;
+
+    for (int l = 0; l < W; ++l) {
+        bool running = L.t[l] < L.tEnd[l];
+        active += running;
+        hs[l] = running ? std::min(L.h[l], L.tEnd[l] - L.t[l]) : 0.0;
+    }
+    if (active == 0) {
+        return 0;
+    }
+
+    for (int l = 0; l < W; ++l) {
+        s2[l] = L.s[l] + hs[l] * (A21 * L.ds[l]);
+        i2[l] = L.i[l] + hs[l] * (A21 * L.di[l]);
+        sirDerivative(L.beta[l], L.gamma[l], s2[l], i2[l], k2s[l], k2i[l]);
+    }
+    for (int l = 0; l < W; ++l) {
+        s3[l] = L.s[l] + hs[l] * (A31 * L.ds[l] + A32 * k2s[l]);
+        i3[l] = L.i[l] + hs[l] * (A31 * L.di[l] + A32 * k2i[l]);
+        sirDerivative(L.beta[l], L.gamma[l], s3[l], i3[l], k3s[l], k3i[l]);
+    }
+    for (int l = 0; l < W; ++l) {
+        s4[l] = L.s[l] + hs[l] * (A41 * L.ds[l] + A42 * k2s[l] + A43 * k3s[l]);
+        i4[l] = L.i[l] + hs[l] * (A41 * L.di[l] + A42 * k2i[l] + A43 * k3i[l]);
+        sirDerivative(L.beta[l], L.gamma[l], s4[l], i4[l], k4s[l], k4i[l]);
+    }
+    for (int l = 0; l < W; ++l) {
+        s5[l] = L.s[l] + hs[l] * (A51 * L.ds[l] + A52 * k2s[l] + A53 * k3s[l] + A54 * k4s[l]);
+        i5[l] = L.i[l] + hs[l] * (A51 * L.di[l] + A52 * k2i[l] + A53 * k3i[l] + A54 * k4i[l]);
+        sirDerivative(L.beta[l], L.gamma[l], s5[l], i5[l], k5s[l], k5i[l]);
+    }
+    for (int l = 0; l < W; ++l) {
+        s6[l] = L.s[l] + hs[l] * (A61 * L.ds[l] + A62 * k2s[l] + A63 * k3s[l] + A64 * k4s[l] + A65 * k5s[l]);
+        i6[l] = L.i[l] + hs[l] * (A61 * L.di[l] + A62 * k2i[l] + A63 * k3i[l] + A64 * k4i[l] + A65 * k5i[l]);
+        sirDerivative(L.beta[l], L.gamma[l], s6[l], i6[l], k6s[l], k6i[l]);
+    }
+    for (int l = 0; l < W; ++l) {
+        s7[l] = L.s[l] + hs[l] * (B1 * L.ds[l] + B3 * k3s[l] + B4 * k4s[l] + B5 * k5s[l] + B6 * k6s[l]);
+        i7[l] = L.i[l] + hs[l] * (B1 * L.di[l] + B3 * k3i[l] + B4 * k4i[l] + B5 * k5i[l] + B6 * k6i[l]);
+        sirDerivative(L.beta[l], L.gamma[l], s7[l], i7[l], k7s[l], k7i[l]);
+    }
+
+    double error[W];
+    for (int l = 0; l < W; ++l) {
+        double errorS = hs[l] * (E1 * L.ds[l] + E3 * k3s[l] + E4 * k4s[l] + E5 * k5s[l] +
+                                 E6 * k6s[l] + E7 * k7s[l]);
+        double errorI = hs[l] * (E1 * L.di[l] + E3 * k3i[l] + E4 * k4i[l] + E5 * k5i[l] +
+                                 E6 * k6i[l] + E7 * k7i[l]);
+        double scaleS = atol + rtol * std::max(std::fabs(L.s[l]), std::fabs(s7[l]));
+        double scaleI = atol + rtol * std::max(std::fabs(L.i[l]), std::fabs(i7[l]));
+        error[l] = std::max(std::fabs(errorS) / scaleS, std::fabs(errorI) / scaleI);
+    }
+
+    for (int l = 0; l < W; ++l) {
+        bool running = hs[l] > 0.0;
+        bool accept = running && error[l] <= 1.0;
+
+        // Peak of i: where di/dt changes sign inside the step, locate it on the
+        // cubic Hermite interpolant through both step ends
+        bool crossesPeak = accept && L.di[l] > 0.0 && k7i[l] <= 0.0;
+        double theta = crossesPeak ? L.di[l] / (L.di[l] - k7i[l]) : 0.0;
+        double theta2 = theta * theta, theta3 = theta2 * theta;
+        double hermite = (2 * theta3 - 3 * theta2 + 1) * L.i[l] +
+                         (theta3 - 2 * theta2 + theta) * hs[l] * L.di[l] +
+                         (-2 * theta3 + 3 * theta2) * i7[l] +
+                         (theta3 - theta2) * hs[l] * k7i[l];
+        double candidatePeak = crossesPeak ? hermite : (accept ? i7[l] : L.peakI[l]);
+        double candidateTime = crossesPeak ? L.t[l] + theta * hs[l] : L.t[l] + hs[l];
+        bool newPeak = candidatePeak > L.peakI[l];
+        L.peakT[l] = newPeak ? candidateTime : L.peakT[l];
+        L.peakI[l] = newPeak ? candidatePeak : L.peakI[l];
+
+        // Step-size controller: h * clamp(0.9 * err^(-1/5), 0.2, 5)
+        double factor = error[l] > 0.0 ? 0.9 * std::pow(error[l], -0.2) : 5.0;
+        factor = std::min(5.0, std::max(0.2, factor));
+        bool clippedToEnd = hs[l] < L.h[l];
+        L.h[l] = !running || (accept && clippedToEnd) ? L.h[l] : hs[l] * factor;
+
+        L.s[l] = accept ? s7[l] : L.s[l];
+        L.i[l] = accept ? i7[l] : L.i[l];
+        L.ds[l] = accept ? k7s[l] : L.ds[l];
+        L.di[l] = accept ? k7i[l] : L.di[l];
+        L.t[l] = accept ? (clippedToEnd ? L.tEnd[l] : L.t[l] + hs[l]) : L.t[l];
+        L.steps[l] += accept;
+    }
+    return active;
+}
+
+} // namespace
+
+// BatchOdeSolver implementation
+BatchOdeSolver::BatchOdeSolver()
+    : relativeTolerance(DEFAULT_RELATIVE_TOLERANCE), absoluteTolerance(DEFAULT_ABSOLUTE_TOLERANCE) {
+}
+
+void BatchOdeSolver::setTolerances(double relative, double absolute) {
+    if (relative <= 0.0 || absolute <= 0.0) {
+        throw std::invalid_argument("ODE tolerances must be positive");
+    }
+    relativeTolerance = relative;
+    absoluteTolerance = absolute;
+}
+
+void BatchOdeSolver::solve(const std::vector<OdeParameters>& parameters, double endTime,
+                           std::vector<OdeOutcome>& outcomes) const {
+    if (endTime <= 0.0) {
+        throw std::invalid_argument("ODE end time must be positive");
+    }
+    outcomes.resize(parameters.size());
+
+    OdeLanes<LANES> lanes;
+    for (std::size_t first = 0; first < parameters.size(); first += LANES) {
+        std::size_t used = std::min<std::size_t>(LANES, parameters.size() - first);
+        for (int l = 0; l < LANES; ++l) {
+            // Unused tail lanes repeat the last parameter set and are discarded
+            const OdeParameters& p = parameters[first + std::min<std::size_t>(l, used - 1)];
+            initializeLane(lanes, l, p.infectionRate, p.recoveryRate,
+                           1.0 - p.initialInfectedFraction, p.initialInfectedFraction, 0.0, endTime);
+        }
+        while (dormandPrinceAttempt(lanes, relativeTolerance, absoluteTolerance) > 0) {
+        }
+        for (std::size_t l = 0; l < used; ++l) {
+            OdeOutcome& outcome = outcomes[first + l];
+            outcome.finalSusceptible = lanes.s[l];
+            outcome.finalInfected = lanes.i[l];
+            outcome.peakInfected = lanes.peakI[l];
+            outcome.peakTime = lanes.peakT[l];
+            outcome.steps = lanes.steps[l];
+        }
+    }
+}
+
+// OdeModel implementation
+OdeModel::OdeModel(int populationSize)
+    : size(populationSize), day(0), susceptible(1.0), infected(0.0),
+      infectionRate(0.0), recoveryRate(0.0), stepSize(INITIAL_STEP), steps(0) {
+    if (populationSize <= 0) {
+        throw std::invalid_argument("Population size must be positive");
+    }
+}
+
+void OdeModel::setInfectionRate(double beta) {
+    if (beta < 0.0) {
+        throw std::invalid_argument("Infection rate must be non-negative");
+    }
+    infectionRate = beta;
+}
+
+void OdeModel::setRecoveryRate(double gamma) {
+    if (gamma < 0.0) {
+        throw std::invalid_argument("Recovery rate must be non-negative");
+    }
+    recoveryRate = gamma;
+}
+
+void OdeModel::setSeed(unsigned int) {
+}
+
+void OdeModel::reset(unsigned int) {
+    day = 0;
+    susceptible = 1.0;
+    infected = 0.0;
+    stepSize = INITIAL_STEP;
+    steps = 0;
+}
+
+void OdeModel::infectRandomPerson() {
+    double amount = std::min(susceptible, 1.0 / size);
+    susceptible -= amount;
+    infected += amount;
+}
+
+void OdeModel::setTransmissionParameters(float probability, double contacts) {
+    setInfectionRate(static_cast<double>(probability) * contacts);
+}
+
+void OdeModel::simulateOneDay() {
+    OdeLanes<1> lane;
+    initializeLane(lane, 0, infectionRate, recoveryRate, susceptible, infected, day, day + 1.0);
+    lane.h[0] = stepSize;
+    while (dormandPrinceAttempt(lane, DEFAULT_RELATIVE_TOLERANCE, DEFAULT_ABSOLUTE_TOLERANCE) > 0) {
+    }
+    susceptible = lane.s[0];
+    infected = lane.i[0];
+    stepSize = lane.h[0];
+    steps += lane.steps[0];
+    day++;
+}
+
+int OdeModel::getSusceptibleCount() const {
+    return static_cast<int>(std::lround(susceptible * size));
+}
+
+int OdeModel::getInfectedCount() const {
+    return static_cast<int>(std::lround(infected * size));
+}
+
+int OdeModel::getRecoveredCount() const {
+    return size - getSusceptibleCount() - getInfectedCount();
+}
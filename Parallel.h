@@ -0,0 +1,117 @@
+/**
+ * @file Parallel.h
+ * @brief Minimal std::thread helpers for static data-parallel loops
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Resolves a requested thread count
+ *
+ * @param threads Requested count; values <= 0 select the hardware concurrency
+ * @return A thread count >= 1
+ */
+inline int resolveThreadCount(int threads) {
+    if (threads > 0) {
+        return threads;
+    }
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? static_cast<int>(hardware) : 1;
+}
+
+/// Smaller batches of scattered per-agent updates are applied on the calling thread
+const std::size_t MIN_PARALLEL_BATCH = std::size_t(1) << 16;
+
+/**
+ * @brief Runs fn(begin, end, thread) over a static contiguous partition of [0, count)
+ *
+ * Thread t always receives the same range for the same (count, threads), which
+ * keeps first-touch placement and per-thread buffers stable between calls.
+ * The calling thread processes partition 0.
+ *
+ * @param count Number of items
+ * @param threads Number of partitions (<= 0 selects the hardware concurrency)
+ * @param fn Callable taking (std::size_t begin, std::size_t end, int thread)
+ */
+template <typename Function>
+void parallelFor(std::size_t count, int threads, Function fn) {
+    int partitions = static_cast<int>(std::min<std::size_t>(resolveThreadCount(threads),
+                                                            std::max<std::size_t>(count, 1)));
+    if (partitions == 1) {
+        fn(std::size_t(0), count, 0);
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(partitions - 1);
+    for (int t = 1; t < partitions; ++t) {
+        std::size_t begin = count * t / partitions;
+        std::size_t end = count * (t + 1) / partitions;
+        workers.emplace_back([=, &fn]() { fn(begin, end, t); });
+    }
+    fn(std::size_t(0), count / partitions, 0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Lock-free combining slot for per-thread partial results
+ *
+ * Workers publish their finished partial result (a sketch, a histogram):
+ * if the slot is empty it takes ownership, otherwise the worker swaps the
+ * occupant out, merges it into its own result outside the slot and tries
+ * again. No thread ever waits on another, merges run concurrently, and once
+ * every worker has published the slot holds the combination of all results
+ * (in an order that depends on timing). T needs merge(const T&).
+ */
+template <typename T>
+class MergeSlot {
+private:
+    std::atomic<T*> slot;   ///< Combined result so far (nullptr when empty or taken)
+
+public:
+    MergeSlot() : slot(nullptr) {}
+    ~MergeSlot() { delete slot.load(); }
+    MergeSlot(const MergeSlot&) = delete;
+    MergeSlot& operator=(const MergeSlot&) = delete;
+
+    /**
+     * @brief Merges a partial result into the slot
+     *
+     * value stays owned until the compare-exchange succeeds, so if merge()
+     * throws it is freed along with the result taken from the slot.
+     */
+    void publish(std::unique_ptr<T> value) {
+        for (;;) {
+            T* expected = nullptr;
+            if (slot.compare_exchange_weak(expected, value.get(), std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+                value.release();
+                return;
+            }
+            std::unique_ptr<T> other(slot.exchange(nullptr, std::memory_order_acq_rel));
+            if (other) {
+                value->merge(*other);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the combined result (nullptr if nothing was published)
+     *
+     * Call after every worker has published (e.g. after parallelFor returns).
+     */
+    std::unique_ptr<T> take() { return std::unique_ptr<T>(slot.exchange(nullptr, std::memory_order_acq_rel)); }
+};
+
+#endif // PARALLEL_H
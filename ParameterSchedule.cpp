@@ -0,0 +1,88 @@
+/**
+ * @file ParameterSchedule.cpp
+ * @brief Implementation of the transmission parameter schedule
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "ParameterSchedule.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+ParameterSchedule::ParameterSchedule(const std::vector<ScheduleKnot>& scheduleKnots) : knots(scheduleKnots) {
+    for (std::size_t k = 0; k < knots.size(); ++k) {
+        const ScheduleKnot& knot = knots[k];
+        if (knot.day < 0 || (k > 0 && knot.day <= knots[k - 1].day)) {
+            throw std::invalid_argument("Schedule days must be non-negative and strictly increasing");
+        }
+        if (!(knot.values.infectionProbability >= 0.0f && knot.values.infectionProbability <= 1.0f) ||
+            !std::isfinite(knot.values.contactsPerDay) || knot.values.contactsPerDay < 0.0) {
+            throw std::invalid_argument("Schedule values must be a probability in [0, 1] and contacts >= 0");
+        }
+    }
+}
+
+ParameterSchedule ParameterSchedule::loadFile(const std::string& path) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        throw std::runtime_error("Cannot open parameter schedule file: " + path);
+    }
+    std::vector<ScheduleKnot> knots;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        ScheduleKnot knot;
+        std::string mode = "step";
+        if (!(fields >> knot.day >> knot.values.infectionProbability >> knot.values.contactsPerDay)) {
+            throw std::runtime_error("Malformed schedule line: " + line);
+        }
+        fields >> mode;
+        if (mode != "step" && mode != "linear") {
+            throw std::runtime_error("Schedule interpolation must be step or linear: " + line);
+        }
+        knot.interpolation = mode == "linear" ? Interpolation::Linear : Interpolation::Step;
+        knots.push_back(knot);
+    }
+    try {
+        return ParameterSchedule(knots);
+    } catch (const std::invalid_argument& error) {
+        throw std::runtime_error(std::string(error.what()) + ": " + path);
+    }
+}
+
+std::size_t ParameterSchedule::positionAt(int day) const {
+    return static_cast<std::size_t>(std::upper_bound(knots.begin(), knots.end(), day,
+                                                     [](int d, const ScheduleKnot& knot) { return d < knot.day; }) -
+                                    knots.begin());
+}
+
+TransmissionParameters ParameterSchedule::valuesAt(int day, const TransmissionParameters& base,
+                                                   std::size_t position) const {
+    const TransmissionParameters& previous = position > 0 ? knots[position - 1].values : base;
+    if (position == knots.size() || knots[position].interpolation == Interpolation::Step) {
+        return previous;
+    }
+    const ScheduleKnot& next = knots[position];
+    const int from = position > 0 ? knots[position - 1].day : 0;
+    const double fraction = static_cast<double>(day - from) / (next.day - from);
+    TransmissionParameters values;
+    values.infectionProbability = static_cast<float>(
+        previous.infectionProbability + fraction * (next.values.infectionProbability - previous.infectionProbability));
+    values.contactsPerDay = previous.contactsPerDay + fraction * (next.values.contactsPerDay - previous.contactsPerDay);
+    return values;
+}
+
+int ParameterSchedule::nextChangeDay(int day, std::size_t position) const {
+    if (position == knots.size()) {
+        return INT_MAX;
+    }
+    return knots[position].interpolation == Interpolation::Linear ? day + 1 : knots[position].day;
+}
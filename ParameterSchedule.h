@@ -0,0 +1,111 @@
+/**
+ * @file ParameterSchedule.h
+ * @brief Day-indexed schedules of the transmission parameters (lockdowns, reopening ramps)
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the ParameterSchedule class: piecewise constant or
+ * piecewise linear infection probability and contacts per day over the
+ * simulation days. ParameterScheduler (Intervention.h) applies it to an engine.
+ */
+
+#ifndef PARAMETER_SCHEDULE_H
+#define PARAMETER_SCHEDULE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How a knot is reached from the previous one
+ */
+enum class Interpolation {
+    Step,       ///< Values jump on the knot's day
+    Linear      ///< Values ramp daily from the previous knot
+};
+
+/**
+ * @brief Transmission parameters in force for one simulated day
+ */
+struct TransmissionParameters {
+    float infectionProbability;         ///< Probability of infection upon contact
+    double contactsPerDay;              ///< Contacts per infected individual per day
+};
+
+/**
+ * @brief Parameter values reached on a given day
+ */
+struct ScheduleKnot {
+    int day;                            ///< Day the values are reached (>= 0)
+    TransmissionParameters values;      ///< Values from this day on (until the next knot)
+    Interpolation interpolation;        ///< Step or linear ramp from the previous knot
+};
+
+/**
+ * @brief Piecewise constant / linear schedule of the transmission parameters
+ *
+ * The configured parameters act as an implicit knot on day 0 (a knot on day 0
+ * replaces them). Before a Step knot the previous values hold; over the days
+ * leading to a Linear knot the values move linearly from the previous knot,
+ * reaching the knot's values on its day. After the last knot its values hold.
+ * "Values on day d" are the parameters used to advance from day d to d + 1.
+ */
+class ParameterSchedule {
+private:
+    std::vector<ScheduleKnot> knots;    ///< Knots in strictly increasing day order
+
+public:
+    /**
+     * @brief Empty schedule (parameters never change)
+     */
+    ParameterSchedule() = default;
+
+    /**
+     * @brief Builds a schedule from knots
+     *
+     * @throws std::invalid_argument unless days are >= 0 and strictly
+     *         increasing, probabilities are in [0, 1] and contacts are finite and >= 0
+     */
+    explicit ParameterSchedule(const std::vector<ScheduleKnot>& knots);
+
+    /**
+     * @brief Loads a schedule from a text file
+     *
+     * One knot per line: "day probability contacts [step|linear]" (step when
+     * omitted). Lines starting with '#' are comments.
+     *
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     */
+    static ParameterSchedule loadFile(const std::string& path);
+
+    /**
+     * @brief Computes the values on a day
+     *
+     * @param day Simulation day
+     * @param base Values before the first knot
+     * @param position Number of knots with day <= the given day
+     */
+    TransmissionParameters valuesAt(int day, const TransmissionParameters& base, std::size_t position) const;
+
+    /**
+     * @brief Gets the first day after the given one whose values may differ
+     *
+     * The next day inside a linear ramp, the next knot's day otherwise, and
+     * INT_MAX after the last knot.
+     *
+     * @param day Simulation day
+     * @param position Number of knots with day <= the given day
+     */
+    int nextChangeDay(int day, std::size_t position) const;
+
+    /**
+     * @brief Gets the number of knots with day <= the given day (binary search)
+     */
+    std::size_t positionAt(int day) const;
+
+    bool empty() const { return knots.empty(); }
+    std::size_t size() const { return knots.size(); }
+    const ScheduleKnot& getKnot(std::size_t index) const { return knots[index]; }
+};
+
+#endif // PARAMETER_SCHEDULE_H
@@ -9,44 +9,55 @@
 #include <stdexcept>
 
 Person::Person() {
-    current = "susceptible";
+    current = HealthState::Susceptible;
     infectionDays = 0;
 }
 
 void Person::updateState() {
-    if (current == "sick") {
+    if (current == HealthState::Infected) {
         infectionDays--;
         if (infectionDays <= 0) {
-            current = "recovered";
+            current = HealthState::Recovered;
             infectionDays = 0;  // Ensure non-negative
         }
     }
 }
 
 void Person::infect(int duration) {
-    if (duration <= 0) {
-        throw std::invalid_argument("Infection duration must be positive");
+    if (duration <= 0 || duration > MAX_INFECTION_DURATION) {
+        throw std::invalid_argument("Infection duration must be between 1 and 255 days");
     }
     
-    if (current == "susceptible") {
+    if (current == HealthState::Susceptible) {
         infectionDays = duration;
-        current = "sick";
+        current = HealthState::Infected;
     }
     // Silently ignore attempts to infect non-susceptible individuals
 }
 
 bool Person::isRecovered() const {
-    return current == "recovered";
+    return current == HealthState::Recovered;
 }
 
 bool Person::isInfected() const {
-    return current == "sick";
+    return current == HealthState::Infected;
 }
 
 bool Person::isSusceptible() const {
-    return current == "susceptible";
+    return current == HealthState::Susceptible;
 }
 
 std::string Person::getStatus() const {
-    return current;
+    switch (current) {
+        case HealthState::Infected:
+            return "sick";
+        case HealthState::Recovered:
+            return "recovered";
+        case HealthState::Exposed:
+            return "exposed";
+        case HealthState::Vaccinated:
+            return "vaccinated";
+        default:
+            return "susceptible";
+    }
 }
@@ -11,8 +11,29 @@
 #ifndef PERSON_H
 #define PERSON_H
 
+#include <cstdint>
 #include <string>
 
+/**
+ * @brief Compact health state code shared by Person and the population arrays
+ *
+ * The numeric values are part of the state kernel contract: recovery is
+ * implemented as `state + 1`, so Recovered must directly follow Infected.
+ * Exposed and Vaccinated are only used by compartment models with a latent
+ * stage or a separate vaccinated compartment (see CompartmentModel), where
+ * they name the reporting class of a compartment.
+ */
+enum class HealthState : std::uint8_t {
+    Susceptible = 0,    ///< Can be infected when exposed
+    Infected = 1,       ///< Infectious, counting down remaining days
+    Recovered = 2,      ///< Immune to further infection
+    Exposed = 3,        ///< Infected but not yet infectious (latent stage)
+    Vaccinated = 4      ///< Protected by vaccination (not by infection)
+};
+
+/// Longest supported infection duration (days remaining are stored in one byte)
+const int MAX_INFECTION_DURATION = 255;
+
 /**
  * @brief Represents an individual in the SIR (Susceptible-Infected-Recovered) model
  * 
@@ -31,7 +52,7 @@
 class Person {
 private:
     int infectionDays;      ///< Number of days remaining to be infectious (0 if not infected)
-    std::string current;    ///< Current health state: "susceptible", "sick", or "recovered"
+    HealthState current;    ///< Current health state (one byte)
 
 public:
     /**
@@ -77,8 +98,8 @@ public:
      * Sets the infection duration and changes state to "sick". Has no effect
      * if the person is already infected or recovered.
      * 
-     * @param duration Number of days the person will remain infectious (must be > 0)
-     * @pre duration > 0
+     * @param duration Number of days the person will remain infectious (1..MAX_INFECTION_DURATION)
+     * @pre 0 < duration <= MAX_INFECTION_DURATION
      * @post If successful, person state becomes "sick" and infectionDays == duration
      */
     void infect(int duration);
@@ -117,6 +138,13 @@ public:
      */
     std::string getStatus() const;
 
+    /**
+     * @brief Gets the compact state code of the person
+     *
+     * @return Current health state
+     */
+    HealthState getState() const { return current; }
+
     /**
      * @brief Gets the remaining infection days
      * 
@@ -1,100 +1,697 @@
 #include "Population.h"
+#include "StateKernels.h"
+#include "ContactNetwork.h"
+#include "GraphOrdering.h"
+#include "Parallel.h"
+#include "Sampling.h"
 #include <random>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
-Population::Population(int populationSize) 
+namespace {
+
+/**
+ * @brief sampleSusceptible() draw source over the population's Mersenne Twister
+ */
+struct MersenneDraws {
+    std::mt19937& rng;
+
+    std::uint32_t below(std::uint32_t range) {
+        return static_cast<std::uint32_t>(std::uniform_int_distribution<>(0, static_cast<int>(range) - 1)(rng));
+    }
+    double unit() { return std::uniform_real_distribution<double>(0.0, 1.0)(rng); }
+};
+
+} // namespace
+
+Population::Population(int populationSize, const StorageOptions& storageOptions) 
     : size(populationSize), day(0), countInfected(0), 
-      countSusceptible(populationSize), countRecovered(0),
-      infectionProbability(0.0), contactsPerDay(0), infectionDuration(0) {
-    
-    // Initialize population with susceptible individuals
-    population.reserve(populationSize);
-    for (int i = 0; i < populationSize; i++) {
-        population.push_back(std::make_unique<Person>());
+      countSusceptible(populationSize), countRecovered(0), countExposed(0),
+      countVaccinated(0), countInfections(0), infectionProbability(0.0), contactsPerDay(0.0), compartments(CompartmentModel::sir(0)),
+      agentSlab(2 * Arena::alignedSize(populationSize), storageOptions.pages),
+      states(agentSlab.allocate<std::uint8_t>(populationSize)),
+      daysLeft(agentSlab.allocate<std::uint8_t>(populationSize)), storage(storageOptions),
+      rng(std::random_device{}()), ageGroups(nullptr), infectiousness(nullptr), susceptibility(nullptr) {
+    applyCompartmentModel();
+    // First touch on this thread: the day loop runs on one thread, and the
+    // kernel places each page on the node of the thread that touches it first
+    fillSusceptible(1);
+}
+
+void Population::applyCompartmentModel() {
+    transitions = compartments.compile();
+    infectiousCode = -1;
+    int infectiousCompartments = 0;
+    for (int c = 0; c < MAX_COMPARTMENTS; ++c) {
+        roles[c] = c < compartments.getCompartmentCount() ? compartments.getCompartment(c).role
+                                                          : HealthState::Susceptible;
+        if (c < compartments.getCompartmentCount() && roles[c] == HealthState::Infected) {
+            infectiousCode = infectiousCompartments++ == 0 ? c : -1;
+        }
     }
+    courseComplete = compartments.isComplete();
+}
+
+int& Population::roleCount(HealthState role) {
+    switch (role) {
+        case HealthState::Infected:
+            return countInfected;
+        case HealthState::Recovered:
+            return countRecovered;
+        case HealthState::Exposed:
+            return countExposed;
+        case HealthState::Vaccinated:
+            return countVaccinated;
+        default:
+            return countSusceptible;
+    }
+}
+
+void Population::fillSusceptible(int threads) {
+    parallelFor(static_cast<std::size_t>(size), threads, [this](std::size_t begin, std::size_t end, int) {
+        std::memset(states + begin, static_cast<int>(HealthState::Susceptible), end - begin);
+        std::memset(daysLeft + begin, 0, end - begin);
+    });
+}
+
+void Population::resetToSusceptible() {
+    // The pages are placed by now, so refilling them in parallel only adds bandwidth
+    fillSusceptible(storage.touchThreads(size));
+    day = 0;
+    countSusceptible = size;
+    countInfected = 0;
+    countRecovered = 0;
+    countExposed = 0;
+    countVaccinated = 0;
+    countInfections = 0;
+}
+
+void Population::setSeed(unsigned int seed) {
+    rng.seed(seed);
+}
+
+void Population::reset(unsigned int seed) {
+    resetToSusceptible();
+    newlyInfected.clear();
+    setSeed(seed);
 }
 
 void Population::infectRandomPerson() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(0, size - 1);
     
-    int index = dis(gen);
-    Person* chosenPerson = population[index].get();
-    infectPerson(chosenPerson);
+    int index = dis(rng);
+    infectPerson(index);
+}
+
+void Population::infectRandomPeople(int count) {
+    if (count < 0 || count > countSusceptible) {
+        throw std::invalid_argument("Cannot infect more people than are susceptible");
+    }
+    MersenneDraws draws = {rng};
+    sampleSusceptible(states, size, countSusceptible, count, draws,
+                      [this](std::uint32_t index) { infectPerson(static_cast<int>(index)); });
+}
+
+void Population::infectPeople(const std::vector<std::uint32_t>& ids) {
+    // Validate the whole list first, so a bad ID leaves the population untouched
+    auto invalid = std::find_if(ids.begin(), ids.end(), [this](std::uint32_t id) {
+        return id >= static_cast<std::uint32_t>(size);
+    });
+    if (invalid != ids.end()) {
+        throw std::out_of_range("Agent ID out of range: " + std::to_string(*invalid));
+    }
+    for (std::uint32_t id : ids) {
+        infectPerson(getAgentSlot(static_cast<int>(id)));
+    }
+}
+
+int Population::vaccinatePeople(const std::uint32_t* ids, std::size_t count) {
+    const int target = compartments.getVaccinationTarget();
+    if (target < 0) {
+        throw std::logic_error("The compartment model has no vaccination target");
+    }
+    const std::uint32_t* invalid = std::find_if(ids, ids + count, [this](std::uint32_t id) {
+        return id >= static_cast<std::uint32_t>(size);
+    });
+    if (invalid != ids + count) {
+        throw std::out_of_range("Agent ID out of range: " + std::to_string(*invalid));
+    }
+    
+    const std::uint8_t susceptible = static_cast<std::uint8_t>(HealthState::Susceptible);
+    const std::uint8_t code = static_cast<std::uint8_t>(target);
+    const std::uint8_t entryDays = transitions.entryDays[target];
+    std::atomic<int> vaccinated(0);
+    parallelFor(count, count < MIN_PARALLEL_BATCH ? 1 : storage.threads,
+                [&](std::size_t begin, std::size_t end, int) {
+        // Doses hit scattered agents: prefetch ahead so the cache misses overlap.
+        // Susceptible agents have no days left, so an untimed target leaves daysLeft alone.
+        const std::size_t distance = 16;
+        int moved = 0;
+        for (std::size_t k = begin; k < end; ++k) {
+            if (k + distance < end) {
+                __builtin_prefetch(states + getAgentSlot(static_cast<int>(ids[k + distance])), 1);
+            }
+            const int slot = getAgentSlot(static_cast<int>(ids[k]));
+            if (states[slot] == susceptible) {
+                states[slot] = code;
+                if (entryDays != 0) {
+                    daysLeft[slot] = entryDays;
+                }
+                moved++;
+            }
+        }
+        vaccinated += moved;
+    });
+    countSusceptible -= vaccinated;
+    roleCount(roles[target]) += vaccinated;
+    return vaccinated;
+}
+
+void Population::setTransmissionParameters(float probability, double contacts) {
+    setInfectionProbability(probability);
+    setContactsPerDay(contacts);
 }
 
 void Population::simulateOneDay() {
-    std::vector<Person*> newlyInfected;
+    newlyInfected.clear();
+    if (!pendingTargets.empty()) {
+        flushTargetUpdates();
+    }
     
-    // Process each person in the population
-    for (auto& person : population) {
-        if (person->isInfected()) {
-            // Infected people can transmit disease
-            simulateTransmission(newlyInfected);
+    // Infectious people can transmit disease (state as of the start of the day)
+    auto transmitFrom = [this](int i) {
+        if (network) {
+            simulateNetworkTransmission(i, newlyInfected);
+        } else if (contactMatrix) {
+            simulateAgeTransmission(i, newlyInfected);
+        } else {
+            simulateTransmission(i, newlyInfected);
+        }
+    };
+    if (infectiousCode >= 0) {
+        // memchr skips the non-infectious stretches with the C library's vector scan
+        const std::uint8_t* end = states + size;
+        for (const void* hit = std::memchr(states, infectiousCode, size); hit != nullptr;
+             hit = std::memchr(static_cast<const std::uint8_t*>(hit) + 1, infectiousCode,
+                               end - static_cast<const std::uint8_t*>(hit) - 1)) {
+            transmitFrom(static_cast<int>(static_cast<const std::uint8_t*>(hit) - states));
+        }
+    } else {
+        for (int i = 0; i < size; ++i) {
+            if (roles[states[i]] == HealthState::Infected) {
+                transmitFrom(i);
+            }
         }
-        // Update each person's state (progression of disease)
-        person->updateState();
+    }
+    
+    // Progression of disease for everyone, fused with the compartment histogram
+    CompartmentCounts counts = progressAndCountCompartments(transitions, states, daysLeft, size);
+    countSusceptible = 0;
+    countInfected = 0;
+    countRecovered = 0;
+    countExposed = 0;
+    countVaccinated = 0;
+    for (int c = 0; c < transitions.compartments; ++c) {
+        roleCount(roles[c]) += static_cast<int>(counts.counts[c]);
     }
     
     // Infect newly infected people
-    for (Person* person : newlyInfected) {
-        infectPerson(person);
+    for (int index : newlyInfected) {
+        infectPerson(index);
     }
     
-    // Update day counter and population counts
+    // Update day counter
     day++;
-    updateCounts();
 }
 
 void Population::setInfectionProbability(float probability) {
     this->infectionProbability = probability;
 }
 
-void Population::setContactsPerDay(int contacts) {
+void Population::setContactsPerDay(double contacts) {
     this->contactsPerDay = contacts;
 }
 
 void Population::setInfectionDuration(int days) {
-    this->infectionDuration = days;
+    if (days > MAX_INFECTION_DURATION) {
+        throw std::invalid_argument("Infection duration must not exceed 255 days");
+    }
+    compartments.setRoleDuration(HealthState::Infected, days);
+    applyCompartmentModel();
 }
 
-void Population::infectPerson(Person* person) {
-    person->infect(infectionDuration);
+void Population::setCompartmentModel(const CompartmentModel& model) {
+    if (countSusceptible != size) {
+        throw std::logic_error("The compartment model can only be replaced while everyone is susceptible");
+    }
+    compartments = model;
+    applyCompartmentModel();
 }
 
-void Population::simulateTransmission(std::vector<Person*>& newlyInfected) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> personDis(0, population.size() - 1);
+void Population::infectPerson(int index) {
+    if (!courseComplete) {
+        throw std::invalid_argument("Infection duration must be positive");
+    }
+    
+    if (states[index] == static_cast<std::uint8_t>(HealthState::Susceptible)) {
+        const int target = compartments.getInfectionTarget();
+        states[index] = static_cast<std::uint8_t>(target);
+        daysLeft[index] = transitions.entryDays[target];
+        countSusceptible--;
+        roleCount(roles[target])++;
+        countInfections++;
+    }
+}
+
+std::uint64_t Population::randomBits() {
+    const std::uint64_t high = static_cast<std::uint32_t>(rng());
+    return (high << 32) | static_cast<std::uint32_t>(rng());
+}
+
+int Population::dailyContacts(int index, double contacts) {
+    const double expected = infectiousness != nullptr ? contacts * decodeRate(infectiousness[index]) : contacts;
+    int whole = static_cast<int>(expected);
+    if (expected > whole && std::uniform_real_distribution<float>(0.0, 1.0)(rng) < expected - whole) {
+        whole++;
+    }
+    return whole;
+}
+
+void Population::simulateTransmission(int index, ScratchBuffer<int>& newlyInfected) {
+    std::uniform_int_distribution<> personDis(0, size - 1);
     std::uniform_real_distribution<float> probDis(0.0, 1.0);
     
-    // Each infected person makes 'contactsPerDay' contacts
-    for (int i = 0; i < contactsPerDay && i < static_cast<int>(population.size()) - 1; ++i) {
+    if (hasHeterogeneousRates()) {
+        // Targets in proportion to susceptibility come from the alias table, which
+        // folds the mean susceptibility into the acceptance probability
+        const int contacts = std::min(dailyContacts(index, contactsPerDay), size - 1);
+        const float threshold = susceptibility != nullptr ? infectionProbability * targetMeans[0] : infectionProbability;
+        for (int c = 0; c < contacts; ++c) {
+            int contactIndex = susceptibility != nullptr ? static_cast<int>(targetTables[0].sample(randomBits()))
+                                                         : personDis(rng);
+            if (states[contactIndex] == static_cast<std::uint8_t>(HealthState::Susceptible) &&
+                probDis(rng) <= threshold) {
+                newlyInfected.push_back(contactIndex);
+            }
+        }
+        return;
+    }
+    
+    // Each infected person makes 'contactsPerDay' contacts (rounded stochastically)
+    const int contacts = std::min(dailyContacts(index, contactsPerDay), size - 1);
+    for (int i = 0; i < contacts; ++i) {
         // Random contact
-        int contactIndex = personDis(gen);
-        Person* contactPerson = population[contactIndex].get();
+        int contactIndex = personDis(rng);
         
         // Check if contact is susceptible and transmission occurs
-        if (contactPerson->isSusceptible() && probDis(gen) <= infectionProbability) {
-            newlyInfected.push_back(contactPerson);
+        if (states[contactIndex] == static_cast<std::uint8_t>(HealthState::Susceptible) &&
+            probDis(rng) <= infectionProbability) {
+            newlyInfected.push_back(contactIndex);
         }
     }
 }
 
-void Population::updateCounts() {
-    countInfected = 0;
-    countSusceptible = 0;
-    countRecovered = 0;
+void Population::simulateNetworkTransmission(int index, ScratchBuffer<int>& newlyInfected) {
+    std::uniform_real_distribution<float> probDis(0.0, 1.0);
+    
+    const float probability = infectiousness != nullptr ? infectionProbability * decodeRate(infectiousness[index])
+                                                        : infectionProbability;
+    const std::uint32_t* end = network->neighborsEnd(static_cast<std::uint32_t>(index));
+    for (const std::uint32_t* neighbor = network->neighborsBegin(static_cast<std::uint32_t>(index));
+         neighbor != end; ++neighbor) {
+        if (states[*neighbor] == static_cast<std::uint8_t>(HealthState::Susceptible) &&
+            probDis(rng) <= (susceptibility != nullptr ? probability * decodeRate(susceptibility[*neighbor])
+                                                       : probability)) {
+            newlyInfected.push_back(static_cast<int>(*neighbor));
+        }
+    }
+}
+
+void Population::simulateAgeTransmission(int index, ScratchBuffer<int>& newlyInfected) {
+    std::uniform_real_distribution<float> probDis(0.0, 1.0);
+    
+    const int group = ageGroups[index];
+    const int contacts = dailyContacts(index, contactMatrix->getRowTotal(group));
+    for (int c = 0; c < contacts; ++c) {
+        // Target group from the matrix row, then a member of its contiguous range
+        // (multiply-shift on raw words; mt19937 yields exactly 32 bits)
+        const int target = contactMatrix->sampleTargetGroup(group, static_cast<std::uint32_t>(rng()));
+        const std::uint32_t first = groupFirst[target];
+        const std::uint64_t members = groupFirst[target + 1] - first;
+        if (members == 0) {
+            continue;
+        }
+        std::uint32_t contact;
+        float threshold = infectionProbability;
+        if (susceptibility != nullptr) {
+            contact = first + targetTables[target].sample(randomBits());
+            threshold *= targetMeans[target];
+        } else {
+            contact = first + static_cast<std::uint32_t>((members * static_cast<std::uint32_t>(rng())) >> 32);
+        }
+        if (states[contact] == static_cast<std::uint8_t>(HealthState::Susceptible) &&
+            probDis(rng) <= threshold) {
+            newlyInfected.push_back(static_cast<int>(contact));
+        }
+    }
+}
+
+void Population::setInfectiousness(const std::vector<float>& rates) {
+    if (rates.empty()) {
+        infectiousnessSlab.reset();
+        infectiousness = nullptr;
+        return;
+    }
+    if (rates.size() != static_cast<std::size_t>(size)) {
+        throw std::invalid_argument("Infectiousness must list one multiplier per individual");
+    }
+    for (float rate : rates) {
+        if (!std::isfinite(rate) || rate < 0.0f) {
+            throw std::invalid_argument("Infectiousness multipliers must be finite and non-negative");
+        }
+    }
+    if (!infectiousnessSlab) {
+        infectiousnessSlab = std::make_unique<Arena>(Arena::alignedSize(size), storage.pages);
+        infectiousness = infectiousnessSlab->allocate<std::uint8_t>(size);
+        std::memset(infectiousness, 0, size);   // first touch on the day-loop thread, as for the states
+    }
+    parallelFor(static_cast<std::size_t>(size), storage.touchThreads(size), [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t id = begin; id < end; ++id) {
+            infectiousness[getAgentSlot(static_cast<int>(id))] = encodeRate(rates[id]);
+        }
+    });
+}
+
+void Population::setSusceptibility(const std::vector<float>& rates) {
+    if (rates.empty()) {
+        susceptibilitySlab.reset();
+        susceptibility = nullptr;
+        rebuildTargetTables();
+        return;
+    }
+    if (rates.size() != static_cast<std::size_t>(size)) {
+        throw std::invalid_argument("Susceptibility must list one weight per individual");
+    }
+    double total = 0.0;
+    for (float rate : rates) {
+        if (!std::isfinite(rate) || rate < 0.0f) {
+            throw std::invalid_argument("Susceptibility weights must be finite and non-negative");
+        }
+        total += rate;
+    }
+    if (total <= 0.0) {
+        throw std::invalid_argument("Susceptibility weights must not all be zero");
+    }
+    if (!susceptibilitySlab) {
+        susceptibilitySlab = std::make_unique<Arena>(Arena::alignedSize(size), storage.pages);
+        susceptibility = susceptibilitySlab->allocate<std::uint8_t>(size);
+        std::memset(susceptibility, 0, size);   // first touch on the day-loop thread, as for the states
+    }
+    const double scale = size / total;
+    parallelFor(static_cast<std::size_t>(size), storage.touchThreads(size), [&](std::size_t begin, std::size_t end, int) {
+        for (std::size_t id = begin; id < end; ++id) {
+            susceptibility[getAgentSlot(static_cast<int>(id))] = encodeRate(rates[id] * scale);
+        }
+    });
+    rebuildTargetTables();
+}
+
+void Population::updateSusceptibility(const std::uint32_t* ids, const float* rates, std::size_t count) {
+    if (susceptibility == nullptr) {
+        throw std::logic_error("Susceptibility updates require setSusceptibility()");
+    }
+    for (std::size_t k = 0; k < count; ++k) {
+        if (ids[k] >= static_cast<std::uint32_t>(size)) {
+            throw std::out_of_range("Agent ID out of range: " + std::to_string(ids[k]));
+        }
+        if (!std::isfinite(rates[k]) || rates[k] < 0.0f) {
+            throw std::invalid_argument("Susceptibility weights must be finite and non-negative");
+        }
+    }
+    for (std::size_t k = 0; k < count; ++k) {
+        const int slot = getAgentSlot(static_cast<int>(ids[k]));
+        susceptibility[slot] = encodeRate(rates[k]);
+        if (!targetTables.empty()) {
+            pendingTargets.push_back(static_cast<std::uint32_t>(slot));
+        }
+    }
+}
+
+void Population::flushTargetUpdates() {
+    auto weight = [this](std::uint32_t first) {
+        return [this, first](std::size_t i) { return static_cast<double>(decodeRate(susceptibility[first + i])); };
+    };
+    if (!contactMatrix) {
+        targetTables[0].update(pendingTargets.data(), pendingTargets.size(), weight(0), storage.threads);
+        targetMeans[0] = static_cast<float>(targetTables[0].getTotalWeight() / size);
+    } else {
+        // Sorting groups the changes by age group, whose index ranges are contiguous
+        std::sort(pendingTargets.begin(), pendingTargets.end());
+        auto begin = pendingTargets.begin();
+        while (begin != pendingTargets.end()) {
+            const int group = ageGroups[*begin];
+            const std::uint32_t first = groupFirst[group];
+            auto end = std::lower_bound(begin, pendingTargets.end(), groupFirst[group + 1]);
+            for (auto it = begin; it != end; ++it) {
+                *it -= first;
+            }
+            targetTables[group].update(&*begin, static_cast<std::size_t>(end - begin), weight(first), storage.threads);
+            targetMeans[group] = static_cast<float>(targetTables[group].getTotalWeight() / (groupFirst[group + 1] - first));
+            begin = end;
+        }
+    }
+    pendingTargets.clear();
+}
+
+void Population::relabelRateColumns(const std::vector<std::uint32_t>& oldToNew) {
+    std::vector<std::uint8_t> relabeled(size);
+    for (std::uint8_t* column : {infectiousness, susceptibility}) {
+        if (column == nullptr) {
+            continue;
+        }
+        for (int i = 0; i < size; ++i) {
+            relabeled[oldToNew[i]] = column[i];
+        }
+        std::copy(relabeled.begin(), relabeled.end(), column);
+    }
+}
+
+void Population::rebuildTargetTables() {
+    targetTables.clear();
+    targetMeans.clear();
+    pendingTargets.clear();
+    if (susceptibility == nullptr || network) {
+        return;
+    }
+    // Tables cover array indices, so they follow the current slot layout
+    const int groups = contactMatrix ? contactMatrix->getGroupCount() : 1;
+    targetTables.resize(groups);
+    targetMeans.assign(groups, 0.0f);
+    for (int g = 0; g < groups; ++g) {
+        const std::uint32_t first = contactMatrix ? groupFirst[g] : 0;
+        const std::uint32_t members = (contactMatrix ? groupFirst[g + 1] : static_cast<std::uint32_t>(size)) - first;
+        targetTables[g].build(members, [this, first](std::size_t i) {
+            return static_cast<double>(decodeRate(susceptibility[first + i]));
+        }, storage.threads);
+        if (members > 0) {
+            targetMeans[g] = static_cast<float>(targetTables[g].getTotalWeight() / members);
+        }
+    }
+}
+
+void Population::setAgeStructure(std::shared_ptr<const ContactMatrix> matrix,
+                                 const std::vector<std::uint8_t>& agentGroups) {
+    if (!matrix) {
+        throw std::invalid_argument("Age structure needs a contact matrix");
+    }
+    if (network) {
+        throw std::logic_error("Age-structured mixing cannot be combined with a contact network");
+    }
+    if (countSusceptible != size) {
+        throw std::logic_error("Age structure can only be set while everyone is susceptible");
+    }
+    const int groups = matrix->getGroupCount();
+    if (!agentGroups.empty() && agentGroups.size() != static_cast<std::size_t>(size)) {
+        throw std::invalid_argument("Age groups must list one group per individual");
+    }
+    std::vector<std::uint32_t> first(groups + 1, 0);
+    for (std::uint8_t group : agentGroups) {
+        if (group >= groups) {
+            throw std::invalid_argument("Age group out of range: " + std::to_string(group));
+        }
+        first[group + 1]++;
+    }
+    
+    std::vector<std::uint32_t> slots;
+    if (agentGroups.empty()) {
+        for (int g = 0; g <= groups; ++g) {
+            first[g] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(size) * g / groups);
+        }
+    } else {
+        for (int g = 0; g < groups; ++g) {
+            first[g + 1] += first[g];
+        }
+        // Counting sort by group; IDs keep their order inside a group. Everyone
+        // is susceptible, so only the slot map changes, not the state arrays.
+        std::vector<std::uint32_t> cursor(first.begin(), first.end() - 1);
+        slots.resize(size);
+        bool identity = true;
+        for (int id = 0; id < size; ++id) {
+            slots[id] = cursor[agentGroups[id]]++;
+            identity = identity && slots[id] == static_cast<std::uint32_t>(id);
+        }
+        if (identity) {
+            std::vector<std::uint32_t>().swap(slots);
+        }
+    }
+    // Per-agent rates are stored by array index and move with their agents
+    if (hasHeterogeneousRates() && slots != agentSlots) {
+        std::vector<std::uint32_t> oldToNew(size);
+        for (int id = 0; id < size; ++id) {
+            oldToNew[getAgentSlot(id)] = slots.empty() ? id : slots[id];
+        }
+        relabelRateColumns(oldToNew);
+    }
+    agentSlots.swap(slots);
+    groupFirst.swap(first);
+    
+    if (!ageSlab) {
+        ageSlab = std::make_unique<Arena>(Arena::alignedSize(size), storage.pages);
+        ageGroups = ageSlab->allocate<std::uint8_t>(size);
+        std::memset(ageGroups, 0, size);        // first touch on the day-loop thread, as for the states
+    }
+    parallelFor(static_cast<std::size_t>(size), storage.touchThreads(size), [this, groups](std::size_t begin, std::size_t end, int) {
+        for (int g = 0; g < groups; ++g) {
+            std::size_t lo = std::max<std::size_t>(begin, groupFirst[g]);
+            std::size_t hi = std::min<std::size_t>(end, groupFirst[g + 1]);
+            if (lo < hi) {
+                std::memset(ageGroups + lo, g, hi - lo);
+            }
+        }
+    });
+    contactMatrix = std::move(matrix);
+    rebuildTargetTables();
+}
+
+void Population::getAgeGroupCounts(HealthState role, std::vector<int>& counts) const {
+    if (!contactMatrix) {
+        throw std::logic_error("The population has no age structure");
+    }
+    counts.assign(contactMatrix->getGroupCount(), 0);
+    for (int g = 0; g < contactMatrix->getGroupCount(); ++g) {
+        for (std::uint32_t i = groupFirst[g]; i < groupFirst[g + 1]; ++i) {
+            counts[g] += roles[states[i]] == role;
+        }
+    }
+}
+
+void Population::setContactNetwork(std::shared_ptr<const ContactNetwork> contactNetwork) {
+    if (contactNetwork && contactNetwork->getNodeCount() != static_cast<std::uint32_t>(size)) {
+        throw std::invalid_argument("Contact network must have one node per individual");
+    }
+    if (contactNetwork && contactMatrix) {
+        throw std::logic_error("Contact networks cannot be combined with age-structured mixing");
+    }
+    if (contactNetwork && !agentSlots.empty()) {
+        contactNetwork = std::make_shared<ContactNetwork>(relabelNetwork(*contactNetwork, agentSlots));
+    }
+    network = std::move(contactNetwork);
+    rebuildTargetTables();
+}
+
+void Population::reorderAgents(NodeOrdering ordering) {
+    if (!network) {
+        throw std::logic_error("Agent reordering requires a contact network");
+    }
+    if (ordering == NodeOrdering::None) {
+        return;
+    }
+    std::vector<std::uint32_t> oldToNew = computeNodeOrdering(*network, ordering);
+    network = std::make_shared<ContactNetwork>(relabelNetwork(*network, oldToNew));
     
-    for (const auto& person : population) {
-        if (person->isInfected()) {
-            countInfected++;
-        } else if (person->isSusceptible()) {
-            countSusceptible++;
-        } else if (person->isRecovered()) {
-            countRecovered++;
+    std::vector<std::uint8_t> reorderedStates(size);
+    std::vector<std::uint8_t> reorderedDaysLeft(size);
+    for (int i = 0; i < size; ++i) {
+        reorderedStates[oldToNew[i]] = states[i];
+        reorderedDaysLeft[oldToNew[i]] = daysLeft[i];
+    }
+    std::copy(reorderedStates.begin(), reorderedStates.end(), states);
+    std::copy(reorderedDaysLeft.begin(), reorderedDaysLeft.end(), daysLeft);
+    relabelRateColumns(oldToNew);
+    
+    // Compose with any earlier reordering so IDs keep referring to the same agents
+    if (agentSlots.empty()) {
+        agentSlots.swap(oldToNew);
+    } else {
+        for (std::uint32_t& slot : agentSlots) {
+            slot = oldToNew[slot];
         }
     }
 }
+
+void Population::getDaysLeftHistogram(std::vector<int>& histogram) const {
+    if (!compartments.isSir()) {
+        throw std::logic_error("Days-left histograms require the SIR compartment model");
+    }
+    histogram.assign(getInfectionDuration() + 1, 0);
+    for (int i = 0; i < size; ++i) {
+        if (states[i] == static_cast<std::uint8_t>(HealthState::Infected)) {
+            histogram[daysLeft[i]]++;
+        }
+    }
+}
+
+void Population::loadCompartments(int currentDay, int susceptible, const std::vector<int>& daysLeftHistogram) {
+    if (network) {
+        throw std::logic_error("Aggregate compartments cannot be loaded into a contact network");
+    }
+    if (contactMatrix) {
+        throw std::logic_error("Aggregate compartments cannot be loaded into an age-structured population");
+    }
+    if (hasHeterogeneousRates()) {
+        throw std::logic_error("Aggregate compartments cannot be loaded into a population with heterogeneous rates");
+    }
+    if (!compartments.isSir()) {
+        throw std::logic_error("Aggregate compartments require the SIR compartment model");
+    }
+    
+    if (!daysLeftHistogram.empty() && daysLeftHistogram[0] != 0) {
+        throw std::invalid_argument("Infected individuals must have at least one day left");
+    }
+    long long infected = 0;
+    for (std::size_t d = 1; d < daysLeftHistogram.size(); ++d) {
+        if (daysLeftHistogram[d] < 0) {
+            throw std::invalid_argument("Compartment counts must be non-negative");
+        }
+        infected += daysLeftHistogram[d];
+    }
+    if (susceptible < 0 || static_cast<long long>(susceptible) + infected > size ||
+        daysLeftHistogram.size() > static_cast<std::size_t>(MAX_INFECTION_DURATION) + 1) {
+        throw std::invalid_argument("Compartment totals do not fit the population");
+    }
+    
+    std::uint8_t* state = states;
+    std::uint8_t* days = daysLeft;
+    std::fill(state, state + susceptible, static_cast<std::uint8_t>(HealthState::Susceptible));
+    std::fill(days, days + susceptible, 0);
+    int next = susceptible;
+    for (std::size_t d = 1; d < daysLeftHistogram.size(); ++d) {
+        std::fill(state + next, state + next + daysLeftHistogram[d], static_cast<std::uint8_t>(HealthState::Infected));
+        std::fill(days + next, days + next + daysLeftHistogram[d], static_cast<std::uint8_t>(d));
+        next += daysLeftHistogram[d];
+    }
+    std::fill(state + next, state + size, static_cast<std::uint8_t>(HealthState::Recovered));
+    std::fill(days + next, days + size, 0);
+    
+    day = currentDay;
+    countSusceptible = susceptible;
+    countInfected = static_cast<int>(infected);
+    countRecovered = size - susceptible - countInfected;
+    // SIR only: everyone who left S was infected (vaccination is not distinguished)
+    countInfections = size - susceptible;
+}
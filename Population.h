@@ -11,17 +11,32 @@
 #ifndef POPULATION_H
 #define POPULATION_H
 
+#include "AgentRates.h"
+#include "AliasTable.h"
+#include "Arena.h"
+#include "CompartmentModel.h"
+#include "ContactMatrix.h"
+#include "EpidemicModel.h"
 #include "Person.h"
-#include <vector>
+#include <cstdint>
 #include <memory>
+#include <random>
+#include <vector>
+
+class ContactNetwork;
+enum class NodeOrdering;
 
 /**
  * @brief Manages a population of individuals in the SIR epidemic model
  * 
  * The Population class is responsible for:
- * - Managing a collection of Person objects
- * - Simulating disease transmission dynamics  
- * - Tracking epidemiological statistics (S, I, R counts)
+ * - Storing individuals as byte-per-agent state arrays holding the
+ *   compartment code of each agent (SIR by default, any CompartmentModel
+ *   such as SEIR or SEIRS on request)
+ * - Simulating disease transmission dynamics (homogeneous mixing, a contact
+ *   network, or age-structured mixing through a ContactMatrix), optionally
+ *   with per-agent infectiousness and susceptibility held in one-byte columns
+ * - Tracking epidemiological statistics (S, E, I, R, V counts)
  * - Configuring simulation parameters
  * - Advancing the simulation state over time
  * 
@@ -31,67 +46,256 @@
  * @note This class is designed for computational efficiency with large populations
  *       while maintaining clear interfaces for parameter configuration.
  */
-class Population {
+class Population : public EpidemicModel {
 private:
     int size;                               ///< Total population size
     int day;                               ///< Current simulation day
     
     // Compartment counts
-    int countInfected;                     ///< Number of currently infected individuals
+    int countInfected;                     ///< Number of currently infectious individuals
     int countSusceptible;                  ///< Number of susceptible individuals
     int countRecovered;                    ///< Number of recovered individuals
+    int countExposed;                      ///< Number of exposed (latent) individuals
+    int countVaccinated;                   ///< Number in a separate vaccinated compartment
+    std::int64_t countInfections;          ///< Infections since day 0 (susceptibles moved by infectPerson())
     
     // Simulation parameters
     float infectionProbability;            ///< Probability of infection upon contact
-    int contactsPerDay;                    ///< Number of contacts per infected person per day
-    int infectionDuration;                 ///< Duration of infection in days
+    double contactsPerDay;                 ///< Mean contacts per infected person per day
+    
+    // Disease course
+    CompartmentModel compartments;          ///< Compartment table (SIR by default)
+    TransitionTable transitions;            ///< compartments compiled for the state kernels
+    HealthState roles[MAX_COMPARTMENTS];    ///< Reporting class of each compartment code
+    int infectiousCode;                     ///< Code of the only infectious compartment (-1 if several)
+    bool courseComplete;                    ///< Every exposed/infectious compartment has a duration
+    
+    Arena agentSlab;                        ///< Single allocation holding every per-agent column
+    std::uint8_t* states;                   ///< Compartment code of each individual (in agentSlab)
+    std::uint8_t* daysLeft;                 ///< Remaining days in the current compartment (in agentSlab)
+    ScratchBuffer<int> newlyInfected;       ///< Infections of the current day (capacity kept between days)
     
-    std::vector<std::unique_ptr<Person>> population;  ///< Container for all individuals
+    StorageOptions storage;                 ///< Page backing and fill threads of the agent columns
+    std::mt19937 rng;                       ///< Random number generator for contacts and seeding
+    std::shared_ptr<const ContactNetwork> network;  ///< Contact network (nullptr = homogeneous mixing)
+    std::vector<std::uint32_t> agentSlots;  ///< Array index of each agent ID after reordering (empty = identity)
+    std::shared_ptr<const ContactMatrix> contactMatrix;  ///< Age-by-age mixing (nullptr = no age structure)
+    std::unique_ptr<Arena> ageSlab;         ///< Allocation holding the age column once age structure is set
+    std::uint8_t* ageGroups;                ///< Age group of each array index (in ageSlab, nullptr without age structure)
+    std::vector<std::uint32_t> groupFirst;  ///< Age group g occupies array indices [groupFirst[g], groupFirst[g + 1])
+    std::unique_ptr<Arena> infectiousnessSlab;  ///< Allocation holding the infectiousness column once set
+    std::uint8_t* infectiousness;           ///< Rate code of each array index (nullptr = equal infectiousness)
+    std::unique_ptr<Arena> susceptibilitySlab;  ///< Allocation holding the susceptibility column once set
+    std::uint8_t* susceptibility;           ///< Rate code of each array index (nullptr = equal susceptibility)
+    std::vector<AliasTable> targetTables;   ///< Contact targets by susceptibility: one table per age group (one without age structure)
+    std::vector<float> targetMeans;         ///< Mean susceptibility covered by each target table
+    std::vector<std::uint32_t> pendingTargets;  ///< Array indices whose susceptibility changed since the tables were built
+
+    /**
+     * @brief Sets every agent to susceptible with a bulk fill
+     * 
+     * @param threads Partitions of parallelFor(); the constructor passes 1 so the
+     *        first touch happens on the thread that runs the day loop
+     */
+    void fillSusceptible(int threads);
+
+    /**
+     * @brief Recompiles the transition table and the per-code lookups after a model change
+     */
+    void applyCompartmentModel();
+
+    /**
+     * @brief Gets the counter of a reporting class
+     */
+    int& roleCount(HealthState role);
 
     /**
      * @brief Helper function to infect a specific person
      * 
-     * @param person Pointer to the person to infect
+     * Has no effect unless the person is susceptible; keeps the compartment
+     * counts in sync with the state arrays.
+     * 
+     * @param index Index of the person to infect
+     */
+    void infectPerson(int index);
+
+    /**
+     * @brief Draws 64 random bits from two 32-bit generator words
+     */
+    std::uint64_t randomBits();
+
+    /**
+     * @brief Number of contacts an infected individual makes today
+     * 
+     * The baseline is scaled by the individual's infectiousness (when set) and
+     * the fractional part becomes one extra contact with that probability.
+     * 
+     * @param index Index of the infected individual
+     * @param contacts Baseline contacts per day
+     */
+    int dailyContacts(int index, double contacts);
+
+    /**
+     * @brief Moves the rate columns along an array relabeling
+     * 
+     * @param oldToNew New array index of every current array index
+     */
+    void relabelRateColumns(const std::vector<std::uint32_t>& oldToNew);
+
+    /**
+     * @brief Rebuilds the susceptibility-weighted target tables after a change of
+     *        susceptibility, age groups or mixing mode
+     */
+    void rebuildTargetTables();
+
+    /**
+     * @brief Applies the queued susceptibility changes to the target tables
+     * 
+     * Each table rebuilds only the blocks holding a changed agent.
      */
-    void infectPerson(Person* person);
+    void flushTargetUpdates();
 
     /**
-     * @brief Simulates disease transmission from infected individuals
+     * @brief Simulates disease transmission from one infected individual
      * 
-     * @param newlyInfected Vector to store newly infected individuals
+     * With heterogeneous rates, the contacts are scaled by the individual's
+     * infectiousness and targets are drawn in proportion to susceptibility
+     * from the alias table, so no susceptibility is read per contact.
+     * 
+     * @param index Index of the infected individual
+     * @param newlyInfected Vector to store indices of newly infected individuals
      */
-    void simulateTransmission(std::vector<Person*>& newlyInfected);
+    void simulateTransmission(int index, ScratchBuffer<int>& newlyInfected);
 
     /**
-     * @brief Updates the compartment counts based on current population state
+     * @brief Simulates transmission along the network edges of one infected individual
+     * 
+     * Each neighbor is one daily contact; only the infected individual's
+     * neighbor range is visited. Heterogeneous rates scale the per-edge
+     * transmission probability by the infectiousness of the individual and
+     * the susceptibility of the neighbor.
+     * 
+     * @param index Index of the infected individual
+     * @param newlyInfected Vector to store indices of newly infected individuals
      */
-    void updateCounts();
+    void simulateNetworkTransmission(int index, ScratchBuffer<int>& newlyInfected);
+
+    /**
+     * @brief Simulates age-structured transmission from one infected individual
+     * 
+     * The individual makes the row total of its age group's contacts (the
+     * fractional part as one extra contact with that probability). Each
+     * contact draws the target age group from the matrix row, then a member
+     * uniformly from the group's contiguous index range (in proportion to
+     * susceptibility from the group's alias table when it varies).
+     * 
+     * @param index Index of the infected individual
+     * @param newlyInfected Vector to store indices of newly infected individuals
+     */
+    void simulateAgeTransmission(int index, ScratchBuffer<int>& newlyInfected);
 
 public:
     /**
      * @brief Constructor to create a population of specified size
      * 
      * @param populationSize Number of individuals in the population
+     * @param storage Page backing of the agent columns and threads for refilling them
      */
-    explicit Population(int populationSize);
+    explicit Population(int populationSize, const StorageOptions& storage = StorageOptions());
 
     /**
      * @brief Destructor
      */
     ~Population() = default;
 
+    /**
+     * @brief Seeds the random number generator used for contacts and seeding
+     * 
+     * The generator is seeded from std::random_device on construction.
+     * 
+     * @param seed Random seed
+     */
+    void setSeed(unsigned int seed) override;
+
     /**
      * @brief Randomly infects one person in the population
      */
-    void infectRandomPerson();
+    void infectRandomPerson() override;
+
+    /**
+     * @brief Infects exactly count distinct susceptible people
+     * 
+     * On an all-susceptible population Floyd's algorithm draws the sample in
+     * O(count) time, using the state column itself as the membership set.
+     * Otherwise small batches (at most a quarter of the susceptibles) redraw
+     * until they hit a susceptible agent, and larger ones use one
+     * selection-sampling pass over the susceptible agents.
+     * 
+     * @param count Number of people to infect
+     * @throws std::invalid_argument if count is negative or exceeds the susceptible count
+     */
+    void infectRandomPeople(int count) override;
+
+    /**
+     * @brief Infects the listed agents (IDs as in getState())
+     * 
+     * @param ids Agent IDs; agents that are not susceptible are skipped
+     * @throws std::out_of_range if an ID is out of range (before anyone is infected)
+     */
+    void infectPeople(const std::vector<std::uint32_t>& ids) override;
+
+    /**
+     * @brief Moves the susceptible agents of a dose batch to the vaccination target
+     * 
+     * Batches of at least MIN_PARALLEL_BATCH doses are split over the storage
+     * threads; the IDs must be distinct.
+     * 
+     * @param ids Agent IDs (as in getState())
+     * @param count Number of IDs
+     * @return Number of agents vaccinated
+     * @throws std::logic_error if the compartment model has no vaccination target
+     * @throws std::out_of_range if an ID is out of range (before any agent is changed)
+     */
+    int vaccinatePeople(const std::uint32_t* ids, std::size_t count) override;
+
+    /**
+     * @brief Returns every individual to susceptible and the clock to day 0
+     * 
+     * A parallel bulk fill of the state columns; parameters, the contact
+     * network, the agent ordering and the generator state are kept.
+     */
+    void resetToSusceptible();
+
+    /**
+     * @brief Starts a new replicate: resetToSusceptible() plus setSeed(seed)
+     * 
+     * Clears the daily infection list without releasing its capacity, so a
+     * replicate loop on a warmed-up population performs no heap allocation
+     * (columns under StorageOptions::MIN_PARALLEL_BYTES are filled without
+     * starting threads).
+     * 
+     * @param seed Random seed of the next replicate
+     */
+    void reset(unsigned int seed) override;
+
+    /**
+     * @brief Sets the infection probability and the contacts per day
+     *
+     * Each infected agent draws floor(c) contacts plus one more with
+     * probability frac(c), so fractional values are kept as a mean (network
+     * and contact-matrix contacts ignore the fractional part).
+     */
+    void setTransmissionParameters(float infectionProbability, double contactsPerDay) override;
 
     /**
      * @brief Advances the simulation by one day
      * 
      * Updates all individual states, handles disease transmission,
-     * and updates population statistics
+     * and updates population statistics (after applying the day's batch of
+     * susceptibility changes to the target tables). Once the scratch list has grown to
+     * the peak daily incidence, a day performs no heap allocation.
      */
-    void simulateOneDay();
+    void simulateOneDay() override;
 
     /**
      * @brief Sets the probability of infection upon contact
@@ -103,27 +307,243 @@ public:
     /**
      * @brief Sets the number of contacts per infected person per day
      * 
-     * @param contacts Number of contacts
+     * @param contacts Mean number of contacts; a fractional part becomes one
+     *        extra contact with that probability (see dailyContacts())
      */
-    void setContactsPerDay(int contacts);
+    void setContactsPerDay(double contacts);
 
     /**
      * @brief Sets the duration of infection in days
      * 
-     * @param days Duration in days
+     * Sets the duration of the infectious compartment(s) of the current
+     * compartment model.
+     * 
+     * @param days Duration in days (1..MAX_INFECTION_DURATION)
+     * @throws std::invalid_argument if days is out of range
      */
     void setInfectionDuration(int days);
 
+    /**
+     * @brief Replaces the disease course (e.g. CompartmentModel::seirs())
+     * 
+     * Tables with the plain SIR layout keep the dedicated SIR kernels.
+     * 
+     * @param model Compartment table
+     * @throws std::logic_error unless every individual is susceptible
+     */
+    void setCompartmentModel(const CompartmentModel& model);
+
+    /**
+     * @brief Restricts contacts to the edges of a contact network
+     * 
+     * In network mode every neighbor of an infected individual is contacted
+     * once per day and contactsPerDay is ignored. Pass nullptr to return to
+     * homogeneous random mixing.
+     * 
+     * The network is labeled by agent ID; after reorderAgents() it is
+     * relabeled into the current array order.
+     * 
+     * @param contactNetwork Network with one node per individual (shared, read-only)
+     * @throws std::invalid_argument if the node count differs from the population size
+     */
+    void setContactNetwork(std::shared_ptr<const ContactNetwork> contactNetwork);
+
+    /**
+     * @brief Switches to age-structured mixing
+     * 
+     * Agents are stored grouped by age: each group occupies one contiguous
+     * range of the state arrays (agents keep their ID order within a group),
+     * and a one-byte age column records the group of every array index.
+     * Contacts then follow the matrix and contactsPerDay is ignored. Agent IDs
+     * seen through getState() and getAgentSlot() are unchanged.
+     * 
+     * @param matrix Age-by-age contact rates (shared, read-only)
+     * @param agentGroups Age group of each agent ID; empty splits the IDs into
+     *                    equal contiguous groups
+     * @throws std::invalid_argument if the matrix is missing, agentGroups has the
+     *         wrong length or a group is out of range
+     * @throws std::logic_error in network mode or unless every individual is susceptible
+     */
+    void setAgeStructure(std::shared_ptr<const ContactMatrix> matrix,
+                         const std::vector<std::uint8_t>& agentGroups = std::vector<std::uint8_t>());
+
+    /**
+     * @brief Gives every agent its own relative infectiousness
+     * 
+     * An infected agent makes contactsPerDay (or its age group's row total)
+     * times its multiplier contacts per day; in network mode the multiplier
+     * scales the per-edge transmission probability instead. Multipliers are
+     * stored as one-byte codes (see encodeRate()) and read only for infected
+     * agents. Gamma-distributed multipliers (gammaRates()) give negative
+     * binomial offspring numbers.
+     * 
+     * @param rates Multiplier of each agent ID; empty restores equal infectiousness
+     * @throws std::invalid_argument if rates has the wrong length or a
+     *         multiplier is negative or not finite
+     */
+    void setInfectiousness(const std::vector<float>& rates);
+
+    /**
+     * @brief Gives every agent its own relative susceptibility
+     * 
+     * Only relative values matter: the weights are normalized to mean 1, so the
+     * population-wide transmission rate is kept. Contact targets are drawn in
+     * proportion to susceptibility from an alias table (one per age group),
+     * which costs 8 bytes per agent on top of the one-byte column. In network
+     * mode the neighbor's susceptibility scales the transmission probability.
+     * 
+     * @param rates Weight of each agent ID; empty restores equal susceptibility
+     * @throws std::invalid_argument if rates has the wrong length, a weight is
+     *         negative or not finite, or every weight is 0
+     */
+    void setSusceptibility(const std::vector<float>& rates);
+
+    /**
+     * @brief Changes the susceptibility of some agents
+     * 
+     * Weights are on the scale of the normalized weights (1 = the mean set by
+     * setSusceptibility()) and are not renormalized, so lowering them lowers
+     * the population's transmission. The target tables are updated in one
+     * batch at the start of the next day, rebuilding only the alias-table
+     * blocks of the changed agents.
+     * 
+     * @param ids Agent IDs
+     * @param rates New weight of each listed agent
+     * @param count Number of agents
+     * @throws std::logic_error unless setSusceptibility() was called
+     * @throws std::out_of_range if an ID is out of range
+     * @throws std::invalid_argument if a weight is negative or not finite
+     */
+    void updateSusceptibility(const std::uint32_t* ids, const float* rates, std::size_t count);
+
+    /**
+     * @brief Relabels the agent arrays so that network neighbors are stored close together
+     * 
+     * Computes the ordering on the current network, moves every agent's state
+     * to its new array index and replaces the network by its relabeled copy.
+     * Agent IDs seen through getState() and getAgentSlot() are unchanged.
+     * 
+     * @param ordering Relabeling strategy
+     * @throws std::logic_error without a contact network
+     */
+    void reorderAgents(NodeOrdering ordering);
+
+    /**
+     * @brief Gets the array index holding an agent
+     * 
+     * @param id Agent ID (0 <= id < size)
+     * @return Array index of the agent (equal to id unless reorderAgents() was called)
+     */
+    int getAgentSlot(int id) const { return agentSlots.empty() ? id : static_cast<int>(agentSlots[id]); }
+
+    /**
+     * @brief Checks whether transmission follows a contact network
+     */
+    bool hasContactNetwork() const { return network != nullptr; }
+
+    /**
+     * @brief Checks whether transmission follows an age-by-age contact matrix
+     */
+    bool hasAgeStructure() const { return contactMatrix != nullptr; }
+
+    /**
+     * @brief Counts the individuals of each age group reported under a role
+     * 
+     * @param role Reporting class (e.g. HealthState::Susceptible)
+     * @param counts Resized to the number of age groups
+     * @throws std::logic_error without age structure
+     */
+    void getAgeGroupCounts(HealthState role, std::vector<int>& counts) const;
+
+    /**
+     * @brief Counts infected individuals by remaining infectious days
+     * 
+     * @param histogram Resized to infectionDuration + 1; histogram[d] receives the
+     *                  number of infected individuals with d days left
+     * @throws std::logic_error unless the compartment model is SIR
+     */
+    void getDaysLeftHistogram(std::vector<int>& histogram) const;
+
+    /**
+     * @brief Replaces the population state with aggregate compartment totals
+     * 
+     * Under homogeneous mixing individuals are exchangeable, so assigning the
+     * first `susceptible` indices to S, the next ones to I (with the given
+     * remaining days) and the rest to R reproduces the aggregate state exactly.
+     * 
+     * @param currentDay Simulation day to resume from
+     * @param susceptible Number of susceptible individuals
+     * @param daysLeftHistogram Infected individuals by remaining days (index = days left,
+     *                          so entry 0 must be zero)
+     * @throws std::invalid_argument if a count is negative, entry 0 is non-zero, or
+     *         the totals exceed the population size
+     * @throws std::logic_error in network or age-structured mode or with
+     *         heterogeneous rates, where individuals are not exchangeable, or
+     *         unless the compartment model is SIR
+     */
+    void loadCompartments(int currentDay, int susceptible, const std::vector<int>& daysLeftHistogram);
+
     // Getters for population statistics
-    int getCurrentDay() const { return day; }
-    int getPopulationSize() const { return size; }
-    int getSusceptibleCount() const { return countSusceptible; }
-    int getInfectedCount() const { return countInfected; }
-    int getRecoveredCount() const { return countRecovered; }
+    int getCurrentDay() const override { return day; }
+    int getPopulationSize() const override { return size; }
+    int getSusceptibleCount() const override { return countSusceptible; }
+    int getInfectedCount() const override { return countInfected; }
+    int getRecoveredCount() const override { return countRecovered; }
+    int getExposedCount() const override { return countExposed; }
+    int getVaccinatedCount() const override { return countVaccinated; }
+    std::int64_t getCumulativeInfections() const override { return countInfections; }
+
+    /**
+     * @brief Gets the health state of one individual
+     * 
+     * @param id Agent ID of the individual (0 <= id < size)
+     * @return Reporting class of the individual's compartment
+     */
+    HealthState getState(int id) const { return roles[states[getAgentSlot(id)]]; }
+
+    /**
+     * @brief Gets the compartment code of one individual (row of getCompartmentModel())
+     * 
+     * @param id Agent ID of the individual (0 <= id < size)
+     */
+    int getCompartment(int id) const { return states[getAgentSlot(id)]; }
+
+    /**
+     * @brief Gets the age group of one individual (0 without age structure)
+     * 
+     * @param id Agent ID of the individual (0 <= id < size)
+     */
+    int getAgeGroup(int id) const { return ageGroups != nullptr ? ageGroups[getAgentSlot(id)] : 0; }
+
+    /**
+     * @brief Gets the number of individuals in an age group
+     */
+    int getAgeGroupSize(int group) const { return static_cast<int>(groupFirst[group + 1] - groupFirst[group]); }
+
+    /**
+     * @brief Gets the stored infectiousness multiplier of one individual (1 when not set)
+     */
+    float getInfectiousness(int id) const {
+        return infectiousness != nullptr ? decodeRate(infectiousness[getAgentSlot(id)]) : 1.0f;
+    }
+
+    /**
+     * @brief Gets the normalized susceptibility of one individual (1 when not set)
+     */
+    float getSusceptibility(int id) const {
+        return susceptibility != nullptr ? decodeRate(susceptibility[getAgentSlot(id)]) : 1.0f;
+    }
+
+    /**
+     * @brief Checks whether infectiousness or susceptibility varies between agents
+     */
+    bool hasHeterogeneousRates() const { return infectiousness != nullptr || susceptibility != nullptr; }
     
     float getInfectionProbability() const { return infectionProbability; }
-    int getContactsPerDay() const { return contactsPerDay; }
-    int getInfectionDuration() const { return infectionDuration; }
+    double getContactsPerDay() const { return contactsPerDay; }
+    PagePolicy getPagePolicy() const { return agentSlab.getPagePolicy(); }
+    int getInfectionDuration() const { return compartments.getRoleDuration(HealthState::Infected); }
+    const CompartmentModel& getCompartmentModel() const { return compartments; }
 };
 
 #endif // POPULATION_H
@@ -0,0 +1,240 @@
+/**
+ * @file QuantileSketch.cpp
+ * @brief Implementation of the KLL sketch and the per-day ensemble quantiles
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+const int QuantileSketch::DEFAULT_K;
+
+QuantileSketch::QuantileSketch(int topCapacity, std::uint64_t seed)
+    : k(topCapacity), retained(0), maxRetained(0), count(0), minimum(0.0), maximum(0.0), coins(seed) {
+    if (k < 8) {
+        throw std::invalid_argument("Quantile sketches need k >= 8");
+    }
+    grow();
+}
+
+void QuantileSketch::grow() {
+    levels.emplace_back();
+    const std::size_t height = levels.size();
+    capacities.resize(height);
+    maxRetained = 0;
+    for (std::size_t h = 0; h < height; ++h) {
+        const double capacity = std::ceil(k * std::pow(2.0 / 3.0, static_cast<double>(height - 1 - h)));
+        capacities[h] = std::max<std::size_t>(8, static_cast<std::size_t>(capacity));
+        maxRetained += capacities[h];
+    }
+}
+
+void QuantileSketch::compress() {
+    for (std::size_t h = 0; h < levels.size(); ++h) {
+        if (levels[h].size() < capacities[h]) {
+            continue;
+        }
+        if (h + 1 == levels.size()) {
+            grow();
+        }
+        std::vector<double>& level = levels[h];
+        std::vector<double>& above = levels[h + 1];
+        std::sort(level.begin(), level.end());
+        // Pairs start after the smallest value on an odd level; the coin picks one value of each pair
+        const std::size_t odd = level.size() & 1;
+        for (std::size_t i = odd + (coins() & 1); i < level.size(); i += 2) {
+            above.push_back(level[i]);
+        }
+        retained -= (level.size() - odd) / 2;
+        level.resize(odd);
+        if (retained < maxRetained) {
+            break;
+        }
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (&other == this) {
+        const QuantileSketch copy(other);
+        merge(copy);
+        return;
+    }
+    if (other.k != k) {
+        throw std::invalid_argument("Only quantile sketches with the same k can be merged");
+    }
+    if (other.count == 0) {
+        return;
+    }
+    while (levels.size() < other.levels.size()) {
+        grow();
+    }
+    for (std::size_t h = 0; h < other.levels.size(); ++h) {
+        levels[h].insert(levels[h].end(), other.levels[h].begin(), other.levels[h].end());
+    }
+    minimum = count == 0 ? other.minimum : std::min(minimum, other.minimum);
+    maximum = count == 0 ? other.maximum : std::max(maximum, other.maximum);
+    count += other.count;
+    retained += other.retained;
+    while (retained >= maxRetained) {
+        compress();
+    }
+}
+
+std::vector<double> QuantileSketch::quantiles(const std::vector<double>& qs) const {
+    for (double q : qs) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::invalid_argument("Quantiles must be in [0, 1]");
+        }
+    }
+    if (count == 0) {
+        throw std::logic_error("Quantile of an empty sketch");
+    }
+    std::vector<std::pair<double, std::uint64_t>> weighted;
+    weighted.reserve(retained);
+    for (std::size_t h = 0; h < levels.size(); ++h) {
+        for (double value : levels[h]) {
+            weighted.emplace_back(value, std::uint64_t(1) << h);
+        }
+    }
+    std::sort(weighted.begin(), weighted.end());
+    std::vector<std::uint64_t> cumulative(weighted.size());
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < weighted.size(); ++i) {
+        total += weighted[i].second;
+        cumulative[i] = total;
+    }
+
+    std::vector<double> values(qs.size());
+    for (std::size_t j = 0; j < qs.size(); ++j) {
+        if (qs[j] == 0.0) {
+            values[j] = minimum;
+        } else if (qs[j] == 1.0) {
+            values[j] = maximum;
+        } else {
+            const double target = qs[j] * static_cast<double>(count);
+            const std::size_t index = static_cast<std::size_t>(
+                std::lower_bound(cumulative.begin(), cumulative.end(), target,
+                                 [](std::uint64_t weight, double rankTarget) { return weight < rankTarget; }) -
+                cumulative.begin());
+            values[j] = weighted[std::min(index, weighted.size() - 1)].first;
+        }
+    }
+    return values;
+}
+
+double QuantileSketch::quantile(double q) const {
+    return quantiles(std::vector<double>(1, q))[0];
+}
+
+double QuantileSketch::rank(double value) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    std::uint64_t below = 0;
+    for (std::size_t h = 0; h < levels.size(); ++h) {
+        for (double retainedValue : levels[h]) {
+            if (retainedValue <= value) {
+                below += std::uint64_t(1) << h;
+            }
+        }
+    }
+    return static_cast<double>(below) / static_cast<double>(count);
+}
+
+void QuantileSketch::clear() {
+    levels.clear();
+    capacities.clear();
+    retained = 0;
+    count = 0;
+    minimum = 0.0;
+    maximum = 0.0;
+    grow();
+}
+
+DailyQuantiles::DailyQuantiles(int lastDay, int k, std::uint64_t seed)
+    : days(lastDay), replicates(0), nextDay(0), last() {
+    if (days < 0) {
+        throw std::invalid_argument("Daily quantiles need a non-negative horizon");
+    }
+    const std::size_t total = static_cast<std::size_t>(days + 1) * DAILY_SERIES_COUNT;
+    sketches.reserve(total);
+    for (std::size_t i = 0; i < total; ++i) {
+        sketches.emplace_back(k, streamSeed(seed, i));
+    }
+}
+
+void DailyQuantiles::record(int day, const double* values) {
+    QuantileSketch* daySketches = &sketches[static_cast<std::size_t>(day) * DAILY_SERIES_COUNT];
+    for (int s = 0; s < DAILY_SERIES_COUNT; ++s) {
+        daySketches[s].add(values[s]);
+    }
+}
+
+void DailyQuantiles::observe(const EpidemicSnapshot& snapshot, std::int64_t incidence) {
+    if (snapshot.day != nextDay && nextDay <= days) {
+        throw std::logic_error("Daily quantiles need the days of a replicate in order from day 0");
+    }
+    if (snapshot.day > days) {
+        return;
+    }
+    last[static_cast<int>(DailySeries::Susceptible)] = snapshot.susceptible;
+    last[static_cast<int>(DailySeries::Exposed)] = snapshot.exposed;
+    last[static_cast<int>(DailySeries::Infected)] = snapshot.infected;
+    last[static_cast<int>(DailySeries::Recovered)] = snapshot.recovered;
+    last[static_cast<int>(DailySeries::Incidence)] = static_cast<double>(incidence);
+    record(snapshot.day, last);
+    nextDay++;
+}
+
+void DailyQuantiles::finishReplicate() {
+    if (nextDay == 0) {
+        throw std::logic_error("A replicate needs at least day 0 before it finishes");
+    }
+    // An ended replicate keeps its final compartments and has no new infections
+    last[static_cast<int>(DailySeries::Incidence)] = 0.0;
+    for (int day = nextDay; day <= days; ++day) {
+        record(day, last);
+    }
+    replicates++;
+    nextDay = 0;
+}
+
+void DailyQuantiles::merge(const DailyQuantiles& other) {
+    if (other.days != days || other.sketches[0].getK() != sketches[0].getK()) {
+        throw std::invalid_argument("Only daily quantiles with the same horizon and k can be merged");
+    }
+    if (nextDay != 0 || other.nextDay != 0) {
+        throw std::logic_error("Daily quantiles cannot be merged while a replicate is in progress");
+    }
+    for (std::size_t i = 0; i < sketches.size(); ++i) {
+        sketches[i].merge(other.sketches[i]);
+    }
+    replicates += other.replicates;
+}
+
+const QuantileSketch& DailyQuantiles::getSketch(DailySeries series, int day) const {
+    if (day < 0 || day > days) {
+        throw std::out_of_range("Day outside the daily quantile horizon: " + std::to_string(day));
+    }
+    return sketches[static_cast<std::size_t>(day) * DAILY_SERIES_COUNT + static_cast<int>(series)];
+}
+
+double DailyQuantiles::quantile(DailySeries series, int day, double q) const {
+    if (replicates == 0) {
+        throw std::logic_error("Daily quantiles need a finished replicate");
+    }
+    return getSketch(series, day).quantile(q);
+}
+
+std::size_t DailyQuantiles::getRetained() const {
+    std::size_t total = 0;
+    for (const QuantileSketch& sketch : sketches) {
+        total += sketch.getRetained();
+    }
+    return total;
+}
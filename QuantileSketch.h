@@ -0,0 +1,231 @@
+/**
+ * @file QuantileSketch.h
+ * @brief Mergeable streaming quantile sketches for replicate ensembles
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the QuantileSketch class (a KLL sketch) and
+ * DailyQuantiles, one sketch per day and reported series, which summarizes
+ * the trajectories of an ensemble without storing them.
+ */
+
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include "EpidemicStatistics.h"
+#include "Random.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief KLL quantile sketch (Karnin, Lang and Liberty, 2016)
+ *
+ * Values enter level 0; a full level is sorted and compacted by keeping every
+ * other value (odd or even positions by a fair coin) on the next level, where
+ * each value stands for twice as many. Level capacities shrink geometrically
+ * (factor 2/3) below the top level's k, so the sketch retains about 3k values
+ * whatever the stream length, and the rank error of a quantile is about
+ * 1.7% of the count at k = 200 (99% of queries; the error falls as 1/k).
+ * The count is kept exactly: an odd level leaves its smallest value behind.
+ *
+ * Sketches built with the same k merge by concatenating their levels and
+ * compacting, with the same error as one sketch over both streams, so worker
+ * threads can each fill their own sketch and merge the results. The coins
+ * come from a seeded SplitMix64, so a sketch is deterministic given its seed
+ * and the order of its inputs and merges.
+ */
+class QuantileSketch {
+public:
+    /// Default top-level capacity
+    static const int DEFAULT_K = 200;
+
+private:
+    int k;                                      ///< Capacity of the top level
+    std::vector<std::vector<double>> levels;    ///< levels[h] holds values of weight 2^h
+    std::vector<std::size_t> capacities;        ///< Capacity of each level
+    std::size_t retained;                       ///< Values held on all levels
+    std::size_t maxRetained;                    ///< Sum of the capacities (compaction trigger)
+    std::uint64_t count;                        ///< Values added (total weight)
+    double minimum;                             ///< Smallest value added
+    double maximum;                             ///< Largest value added
+    SplitMix64 coins;                           ///< Source of the compaction offsets
+
+    /**
+     * @brief Adds a level on top and recomputes the capacities
+     */
+    void grow();
+
+    /**
+     * @brief Compacts full levels, lowest first, until the sketch is under its capacity
+     */
+    void compress();
+
+public:
+    /**
+     * @brief Empty sketch
+     *
+     * @param k Top-level capacity (>= 8); larger k is more accurate and retains more values
+     * @param seed Seed of the compaction coins
+     * @throws std::invalid_argument if k is too small
+     */
+    explicit QuantileSketch(int k = DEFAULT_K, std::uint64_t seed = 0);
+
+    /**
+     * @brief Adds one value (amortized O(log k))
+     */
+    void add(double value) {
+        levels[0].push_back(value);
+        if (count == 0 || value < minimum) {
+            minimum = value;
+        }
+        if (count == 0 || value > maximum) {
+            maximum = value;
+        }
+        count++;
+        if (++retained >= maxRetained) {
+            compress();
+        }
+    }
+
+    /**
+     * @brief Adds every value of another sketch
+     *
+     * @throws std::invalid_argument if the sketches have different k
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * @brief Gets a value whose rank is about q * count
+     *
+     * @param q Quantile in [0, 1]; 0 and 1 give the exact minimum and maximum
+     * @throws std::invalid_argument if q is outside [0, 1]
+     * @throws std::logic_error if the sketch is empty
+     */
+    double quantile(double q) const;
+
+    /**
+     * @brief Gets several quantiles with one pass over the retained values
+     *
+     * @param qs Quantiles in [0, 1]
+     * @return The quantile of each entry of qs
+     * @throws as quantile()
+     */
+    std::vector<double> quantiles(const std::vector<double>& qs) const;
+
+    /**
+     * @brief Gets the estimated fraction of the values that are <= value
+     */
+    double rank(double value) const;
+
+    /**
+     * @brief Removes every value (keeps k and the coin stream)
+     */
+    void clear();
+
+    /**
+     * @brief Gets the normalized rank error of a sketch with top-level capacity k
+     *
+     * A bound that 99% of quantile queries meet: 1.7% of the count at k = 200.
+     */
+    static double rankErrorBound(int k) { return 3.4 / k; }
+
+    bool empty() const { return count == 0; }
+    int getK() const { return k; }
+    std::uint64_t getCount() const { return count; }
+    std::size_t getRetained() const { return retained; }
+    double getMin() const { return minimum; }
+    double getMax() const { return maximum; }
+};
+
+/**
+ * @brief Series reported every day, as in the daily output
+ */
+enum class DailySeries {
+    Susceptible,
+    Exposed,
+    Infected,
+    Recovered,
+    Incidence
+};
+
+/// Number of DailySeries values
+const int DAILY_SERIES_COUNT = 5;
+
+/**
+ * @brief Per-day quantiles of an ensemble of trajectories
+ *
+ * Holds one QuantileSketch per day 0..days and series. A replicate feeds its
+ * daily snapshots in order with observe(); finishReplicate() carries its last
+ * day forward to the horizon (incidence 0), so replicates that ended early
+ * still count on later days. Memory is about 3k values per sketch whatever
+ * the number of replicates; ensembles merge like the sketches.
+ */
+class DailyQuantiles {
+private:
+    int days;                                   ///< Last day kept
+    std::vector<QuantileSketch> sketches;       ///< sketches[day * DAILY_SERIES_COUNT + series]
+    std::uint64_t replicates;                   ///< Finished replicates
+    int nextDay;                                ///< Next day expected from the current replicate
+    double last[DAILY_SERIES_COUNT];            ///< Last observed values of the current replicate
+
+    void record(int day, const double* values);
+
+public:
+    /**
+     * @brief Empty summary of days 0..days
+     *
+     * @param days Last day kept (>= 0), normally SimulationConfig::simulationDays
+     * @param k Sketch top-level capacity
+     * @param seed Seed of the sketches' coins (each sketch gets its own stream)
+     * @throws std::invalid_argument if days is negative or k too small
+     */
+    explicit DailyQuantiles(int days, int k = QuantileSketch::DEFAULT_K, std::uint64_t seed = 0);
+
+    /**
+     * @brief Adds one day of the current replicate
+     *
+     * @param snapshot Counts at the end of the day (days after the horizon are ignored)
+     * @param incidence New infections on that day
+     * @throws std::logic_error unless days arrive in order from day 0
+     */
+    void observe(const EpidemicSnapshot& snapshot, std::int64_t incidence);
+
+    /**
+     * @brief Ends the current replicate, holding its last state to the horizon
+     */
+    void finishReplicate();
+
+    /**
+     * @brief Adds the replicates of another summary
+     *
+     * @throws std::invalid_argument if the horizons or k differ
+     * @throws std::logic_error if a replicate is in progress on either side
+     */
+    void merge(const DailyQuantiles& other);
+
+    /**
+     * @brief Gets a quantile of a series on a day
+     *
+     * @throws std::out_of_range if the day is outside 0..days
+     * @throws std::logic_error if no replicate has finished
+     */
+    double quantile(DailySeries series, int day, double q) const;
+
+    /**
+     * @brief Gets the sketch of a series on a day
+     *
+     * @throws std::out_of_range if the day is outside 0..days
+     */
+    const QuantileSketch& getSketch(DailySeries series, int day) const;
+
+    int getDays() const { return days; }
+    std::uint64_t getReplicates() const { return replicates; }
+
+    /**
+     * @brief Gets the values retained by all sketches (the memory is 8 bytes each)
+     */
+    std::size_t getRetained() const;
+};
+
+#endif // QUANTILE_SKETCH_H
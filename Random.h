@@ -0,0 +1,79 @@
+/**
+ * @file Random.h
+ * @brief Small, splittable random number utilities for parallel and counter-based use
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * std::mt19937 remains the generator of the serial engines. The helpers here
+ * derive independent, reproducible streams from (seed, stream id) pairs so that
+ * parallel code produces the same numbers regardless of the thread count.
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief SplitMix64 finalizer: a fast, well-mixed 64-bit hash
+ */
+inline std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Derives the seed of an independent stream from a base seed
+ *
+ * @param seed Base seed
+ * @param stream Stream identifier (block index, agent index, day, ...)
+ */
+inline std::uint64_t streamSeed(std::uint64_t seed, std::uint64_t stream) {
+    return splitmix64(seed ^ splitmix64(stream));
+}
+
+/**
+ * @brief Maps 64 random bits to a double in [0, 1)
+ */
+inline double unitInterval(std::uint64_t bits) {
+    return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief Maps 64 random bits to an integer in [0, range) (range < 2^53)
+ */
+inline std::uint64_t boundedRandom(std::uint64_t bits, std::uint64_t range) {
+    return static_cast<std::uint64_t>(unitInterval(bits) * static_cast<double>(range));
+}
+
+/**
+ * @brief SplitMix64 generator satisfying UniformRandomBitGenerator
+ *
+ * Eight bytes of state, so one generator per block, lane or thread is cheap.
+ */
+class SplitMix64 {
+private:
+    std::uint64_t state;    ///< Generator state
+
+public:
+    typedef std::uint64_t result_type;
+
+    explicit SplitMix64(std::uint64_t seed = 0) : state(seed) {}
+
+    void seed(std::uint64_t value) { state = value; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif // RANDOM_H
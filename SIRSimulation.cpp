@@ -6,7 +6,20 @@
  */
 
 #include "Simulation.h"
+#include "GillespieModel.h"
+#include "TauLeapModel.h"
+#include "OdeModel.h"
+#include "HybridModel.h"
+#include "MetapopulationModel.h"
+#include "ContactNetwork.h"
+#include "ContactMatrix.h"
+#include "Random.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <fstream>
 #include <iostream>
+#include <random>
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
@@ -16,7 +29,15 @@ SimulationConfig::SimulationConfig(int popSize, int initInfections, int simDays,
                                   float infProb, int contacts, int duration)
     : populationSize(popSize), initialInfections(initInfections), 
       simulationDays(simDays), infectionProbability(infProb),
-      contactsPerDay(contacts), infectionDuration(duration) {
+      contactsPerDay(contacts), infectionDuration(duration),
+      engine(SimulationEngine::Agent), seed(0),
+      hybridSwitchPrevalence(0.01), hybridReturnPrevalence(0.001),
+      networkOrdering(NodeOrdering::None), patchCount(1), patchMobility(0.05),
+      pagePolicy(PagePolicy::Default), threads(0), latentDays(0), immunityDays(0),
+      vaccinationDosesPerDay(0), vaccinationStartDay(0), vaccinatedCompartment(false),
+      infectiousnessDispersion(0.0), susceptibilityDispersion(0.0), stopAttackRate(0.0),
+      stopPrevalence(0.0), stopPrevalenceDays(7), stopPeakDecline(0.0), stopPeakMinimum(0),
+      stopWallSeconds(0.0) {
     
     if (!isValid()) {
         throw std::invalid_argument("Invalid simulation configuration parameters");
@@ -31,7 +52,38 @@ bool SimulationConfig::isValid() const {
            infectionProbability >= 0.0f && 
            infectionProbability <= 1.0f &&
            contactsPerDay >= 0 &&
-           infectionDuration > 0;
+           infectionDuration > 0 &&
+           infectionDuration <= MAX_INFECTION_DURATION &&
+           hybridSwitchPrevalence > 0.0 &&
+           hybridSwitchPrevalence <= 1.0 &&
+           hybridReturnPrevalence >= 0.0 &&
+           hybridReturnPrevalence < hybridSwitchPrevalence &&
+           (contactNetworkFile.empty() || engine == SimulationEngine::Agent) &&
+           patchCount >= 1 &&
+           patchCount <= populationSize &&
+           patchMobility >= 0.0 &&
+           patchMobility <= 1.0 &&
+           (mobilityFile.empty() || engine == SimulationEngine::Metapopulation) &&
+           (initialInfectionFile.empty() || engine == SimulationEngine::Agent ||
+            engine == SimulationEngine::Hybrid || engine == SimulationEngine::Metapopulation) &&
+           latentDays >= 0 && latentDays <= MAX_INFECTION_DURATION &&
+           immunityDays >= 0 && immunityDays <= MAX_INFECTION_DURATION &&
+           ((latentDays == 0 && immunityDays == 0) || engine == SimulationEngine::Agent) &&
+           vaccinationDosesPerDay >= 0 && vaccinationStartDay >= 0 &&
+           (vaccinationDosesPerDay == 0 || engine == SimulationEngine::Agent ||
+            engine == SimulationEngine::Metapopulation) &&
+           (vaccinationPriorityFile.empty() || vaccinationDosesPerDay > 0) &&
+           (!vaccinatedCompartment || (engine == SimulationEngine::Agent && vaccinationDosesPerDay > 0)) &&
+           (contactMatrixFile.empty() || (engine == SimulationEngine::Agent && contactNetworkFile.empty())) &&
+           (ageGroupFile.empty() || !contactMatrixFile.empty()) &&
+           infectiousnessDispersion >= 0.0 && std::isfinite(infectiousnessDispersion) &&
+           susceptibilityDispersion >= 0.0 && std::isfinite(susceptibilityDispersion) &&
+           ((infectiousnessDispersion == 0.0 && susceptibilityDispersion == 0.0) ||
+            engine == SimulationEngine::Agent) &&
+           stopAttackRate >= 0.0 && stopAttackRate <= 1.0 &&
+           stopPrevalence >= 0.0 && stopPrevalence <= 1.0 && stopPrevalenceDays >= 1 &&
+           stopPeakDecline >= 0.0 && stopPeakDecline < 1.0 && stopPeakMinimum >= 0 &&
+           stopWallSeconds >= 0.0 && std::isfinite(stopWallSeconds);
 }
 
 std::string SimulationConfig::toString() const {
@@ -42,37 +94,514 @@ std::string SimulationConfig::toString() const {
         << "Days: " << simulationDays << ", "
         << "Infection Prob: " << infectionProbability << ", "
         << "Contacts/Day: " << contactsPerDay << ", "
-        << "Duration: " << infectionDuration << " days";
+        << "Duration: " << infectionDuration << " days, "
+        << "Engine: " << simulationEngineName(engine);
+    if (pagePolicy != PagePolicy::Default) {
+        oss << ", Pages: " << pagePolicyName(pagePolicy);
+    }
+    if (engine == SimulationEngine::Metapopulation) {
+        oss << ", Patches: " << patchCount;
+        if (!mobilityFile.empty()) {
+            oss << ", Mobility: " << mobilityFile;
+        } else {
+            oss << ", Grid Mobility: " << patchMobility;
+        }
+    }
+    if (!contactNetworkFile.empty()) {
+        oss << ", Network: " << contactNetworkFile;
+        if (networkOrdering != NodeOrdering::None) {
+            oss << " (" << nodeOrderingName(networkOrdering) << " order)";
+        }
+    }
+    if (!initialInfectionFile.empty()) {
+        oss << ", Seeds: " << initialInfectionFile;
+    }
+    if (!contactMatrixFile.empty()) {
+        oss << ", Contact Matrix: " << contactMatrixFile;
+        if (!ageGroupFile.empty()) {
+            oss << " (ages: " << ageGroupFile << ")";
+        }
+    }
+    if (!parameterSchedule.empty()) {
+        oss << ", Schedule: " << parameterSchedule.size() << " changes";
+    }
+    if (infectiousnessDispersion > 0.0) {
+        oss << ", Infectiousness k=" << infectiousnessDispersion;
+    }
+    if (susceptibilityDispersion > 0.0) {
+        oss << ", Susceptibility k=" << susceptibilityDispersion;
+    }
+    if (latentDays > 0 || immunityDays > 0) {
+        oss << ", Model: " << getCompartmentModel().getName();
+        if (latentDays > 0) {
+            oss << " (latent " << latentDays << " days";
+        } else {
+            oss << " (";
+        }
+        if (immunityDays > 0) {
+            oss << (latentDays > 0 ? ", " : "") << "immunity " << immunityDays << " days";
+        }
+        oss << ")";
+    }
+    if (stopAttackRate > 0.0) {
+        oss << ", Stop at Attack Rate: " << 100.0 * stopAttackRate << "%";
+    }
+    if (stopPrevalence > 0.0) {
+        oss << ", Stop below Prevalence: " << std::setprecision(3) << 100.0 * stopPrevalence << "% for "
+            << stopPrevalenceDays << " days" << std::setprecision(2);
+    }
+    if (stopPeakDecline > 0.0) {
+        oss << ", Stop at Peak Decline: " << 100.0 * stopPeakDecline << "%";
+    }
+    if (stopWallSeconds > 0.0) {
+        oss << ", Wall Budget: " << stopWallSeconds << " s";
+    }
+    if (vaccinationDosesPerDay > 0) {
+        oss << ", Vaccination: " << vaccinationDosesPerDay << " doses/day from day " << vaccinationStartDay
+            << " (" << (vaccinationPriorityFile.empty() ? std::string("random order") : vaccinationPriorityFile)
+            << (vaccinatedCompartment ? ", into V)" : ")");
+    }
     return oss.str();
 }
 
+CompartmentModel SimulationConfig::getCompartmentModel() const {
+    CompartmentModel course = CompartmentModel::sir(infectionDuration);
+    if (latentDays > 0) {
+        course = immunityDays > 0 ? CompartmentModel::seirs(latentDays, infectionDuration, immunityDays)
+                                  : CompartmentModel::seir(latentDays, infectionDuration);
+    } else if (immunityDays > 0) {
+        course = CompartmentModel::sirs(infectionDuration, immunityDays);
+    }
+    return vaccinatedCompartment ? course.withVaccinated(0) : course;
+}
+
+StorageOptions SimulationConfig::getStorageOptions() const {
+    StorageOptions storage;
+    storage.pages = pagePolicy;
+    storage.threads = threads;
+    return storage;
+}
+
+const char* simulationEngineName(SimulationEngine engine) {
+    switch (engine) {
+        case SimulationEngine::Gillespie:
+            return "gillespie";
+        case SimulationEngine::TauLeap:
+            return "tau-leap";
+        case SimulationEngine::ODE:
+            return "ode";
+        case SimulationEngine::Hybrid:
+            return "hybrid";
+        case SimulationEngine::Metapopulation:
+            return "metapopulation";
+        default:
+            return "agent";
+    }
+}
+
 // SIRSimulation implementation
+const std::string SIRSimulation::NO_STOP_REASON;
+const std::string SIRSimulation::DAY_LIMIT_REASON = "day limit reached";
+
 SIRSimulation::SIRSimulation(const SimulationConfig& simConfig) 
-    : config(simConfig), population(simConfig.populationSize) {
+    : config(simConfig), population(nullptr), constructionSeconds(0.0), timeToFirstDay(0.0), campaign(nullptr),
+      scheduler(nullptr), stopReason(&NO_STOP_REASON), statistics(0, 1), dailyQuantiles(nullptr) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
     
     // Validate configuration
     if (!config.isValid()) {
         throw std::invalid_argument("Invalid simulation configuration: " + config.toString());
     }
+    statistics = EpidemicStatistics(config.latentDays, config.infectionDuration);
+    
+    if (config.engine == SimulationEngine::Gillespie) {
+        // Mean-field rates equivalent to the agent parameters
+        auto gillespie = std::make_unique<GillespieModel>(config.populationSize);
+        gillespie->setInfectionRate(config.getInfectionRate());
+        gillespie->setRecoveryRate(config.getRecoveryRate());
+        model = std::move(gillespie);
+    } else if (config.engine == SimulationEngine::TauLeap) {
+        auto tauLeap = std::make_unique<TauLeapModel>(config.populationSize);
+        tauLeap->setInfectionRate(config.getInfectionRate());
+        tauLeap->setRecoveryRate(config.getRecoveryRate());
+        model = std::move(tauLeap);
+    } else if (config.engine == SimulationEngine::ODE) {
+        auto ode = std::make_unique<OdeModel>(config.populationSize);
+        ode->setInfectionRate(config.getInfectionRate());
+        ode->setRecoveryRate(config.getRecoveryRate());
+        model = std::move(ode);
+    } else if (config.engine == SimulationEngine::Hybrid) {
+        auto hybrid = std::make_unique<HybridModel>(config.populationSize);
+        hybrid->setInfectionProbability(config.infectionProbability);
+        hybrid->setContactsPerDay(config.contactsPerDay);
+        hybrid->setInfectionDuration(config.infectionDuration);
+        hybrid->setSwitchThresholds(config.hybridSwitchPrevalence, config.hybridReturnPrevalence);
+        model = std::move(hybrid);
+    } else if (config.engine == SimulationEngine::Metapopulation) {
+        auto metapopulation = std::make_unique<MetapopulationModel>(
+            MetapopulationModel::evenPatchSizes(config.populationSize, config.patchCount),
+            config.getStorageOptions());
+        metapopulation->setInfectionProbability(config.infectionProbability);
+        metapopulation->setContactsPerDay(config.contactsPerDay);
+        metapopulation->setInfectionDuration(config.infectionDuration);
+        const std::uint32_t patches = static_cast<std::uint32_t>(config.patchCount);
+        metapopulation->setMobility(config.mobilityFile.empty()
+                                        ? MobilityMatrix::grid(patches, config.patchMobility)
+                                        : MobilityMatrix::loadFile(config.mobilityFile, patches));
+        model = std::move(metapopulation);
+    } else {
+        // Configure population parameters
+        auto agents = std::make_unique<Population>(config.populationSize, config.getStorageOptions());
+        agents->setInfectionProbability(config.infectionProbability);
+        agents->setContactsPerDay(config.contactsPerDay);
+        agents->setCompartmentModel(config.getCompartmentModel());
+        if (!config.contactMatrixFile.empty()) {
+            auto matrix = std::make_shared<ContactMatrix>(ContactMatrix::loadFile(config.contactMatrixFile));
+            agents->setAgeStructure(matrix, config.ageGroupFile.empty()
+                                                ? std::vector<std::uint8_t>()
+                                                : loadAgeGroups(config.ageGroupFile, config.populationSize,
+                                                                matrix->getGroupCount()));
+        }
+        if (!config.contactNetworkFile.empty()) {
+            agents->setContactNetwork(std::make_shared<ContactNetwork>(ContactNetwork::loadEdgeList(
+                config.contactNetworkFile, static_cast<std::uint32_t>(config.populationSize))));
+            if (config.networkOrdering != NodeOrdering::None) {
+                agents->reorderAgents(config.networkOrdering);
+            }
+        }
+        population = agents.get();
+        model = std::move(agents);
+    }
     
-    // Configure population parameters
-    population.setInfectionProbability(config.infectionProbability);
-    population.setContactsPerDay(config.contactsPerDay);
-    population.setInfectionDuration(config.infectionDuration);
+    if (!config.initialInfectionFile.empty()) {
+        initialInfectionIds = loadAgentIds(config.initialInfectionFile, config.populationSize);
+    }
+    
+    const unsigned int runSeed = config.seed != 0 ? config.seed : std::random_device{}();
+    model->setSeed(runSeed);
+    
+    if (population != nullptr) {
+        // Streams 2 and 3 of the run seed; the rates are kept by every replicate of the run
+        const std::size_t agents = static_cast<std::size_t>(config.populationSize);
+        if (config.infectiousnessDispersion > 0.0) {
+            population->setInfectiousness(gammaRates(agents, config.infectiousnessDispersion,
+                                                     streamSeed(runSeed, 2), config.threads));
+        }
+        if (config.susceptibilityDispersion > 0.0) {
+            population->setSusceptibility(gammaRates(agents, config.susceptibilityDispersion,
+                                                     streamSeed(runSeed, 3), config.threads));
+        }
+    }
+    
+    if (!config.parameterSchedule.empty()) {
+        TransmissionParameters base;
+        base.infectionProbability = config.infectionProbability;
+        base.contactsPerDay = config.contactsPerDay;
+        auto parameters = std::make_unique<ParameterScheduler>(config.parameterSchedule, base);
+        scheduler = parameters.get();
+        interventions.push_back(std::move(parameters));
+    }
+    if (config.vaccinationDosesPerDay > 0) {
+        std::unique_ptr<VaccinationCampaign> vaccination;
+        if (!config.vaccinationPriorityFile.empty()) {
+            PriorityGroup priority;
+            priority.name = config.vaccinationPriorityFile;
+            priority.ids = loadAgentIds(config.vaccinationPriorityFile, config.populationSize);
+            vaccination = std::make_unique<VaccinationCampaign>(config.populationSize, std::vector<PriorityGroup>{priority},
+                                                                config.vaccinationDosesPerDay, config.vaccinationStartDay);
+        } else {
+            // Stream 1 of the run seed: the order does not share draws with the engine
+            vaccination = std::make_unique<VaccinationCampaign>(VaccinationCampaign::randomOrder(
+                config.populationSize, streamSeed(runSeed, 1), config.vaccinationDosesPerDay,
+                config.vaccinationStartDay));
+        }
+        campaign = vaccination.get();
+        interventions.push_back(std::move(vaccination));
+    }
+    
+    // Extinction first: an ended epidemic is reported as such
+    stoppingCriteria.push_back(std::make_unique<ExtinctionCriterion>());
+    if (config.stopAttackRate > 0.0) {
+        stoppingCriteria.push_back(std::make_unique<AttackRateCriterion>(config.stopAttackRate));
+    }
+    if (config.stopPrevalence > 0.0) {
+        stoppingCriteria.push_back(
+            std::make_unique<PrevalenceFloorCriterion>(config.stopPrevalence, config.stopPrevalenceDays));
+    }
+    if (config.stopPeakDecline > 0.0) {
+        stoppingCriteria.push_back(
+            std::make_unique<PeakDeclineCriterion>(config.stopPeakDecline, config.stopPeakMinimum));
+    }
+    if (config.stopWallSeconds > 0.0) {
+        stoppingCriteria.push_back(std::make_unique<WallClockCriterion>(config.stopWallSeconds));
+    }
+    constructionSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+SIRSimulation::SIRSimulation(const SimulationConfig& simConfig, std::shared_ptr<const ContactNetwork> network)
+    : SIRSimulation(simConfig) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (population == nullptr) {
+        throw std::invalid_argument("Contact networks require the agent engine");
+    }
+    population->setContactNetwork(std::move(network));
+    if (config.networkOrdering != NodeOrdering::None && population->hasContactNetwork()) {
+        population->reorderAgents(config.networkOrdering);
+    }
+    constructionSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+const Population& SIRSimulation::getPopulation() const {
+    if (population == nullptr) {
+        throw std::logic_error(std::string("No agent population for engine: ") +
+                               simulationEngineName(config.engine));
+    }
+    return *population;
+}
+
+std::vector<std::uint32_t> SIRSimulation::loadAgentIds(const std::string& path, int populationSize) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        throw std::runtime_error("Cannot open agent ID file: " + path);
+    }
+    std::vector<std::uint32_t> ids;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        long long id = 0;
+        while (fields >> id) {
+            if (id < 0 || id >= populationSize) {
+                throw std::runtime_error("Agent ID out of range in " + path + ": " + std::to_string(id));
+            }
+            ids.push_back(static_cast<std::uint32_t>(id));
+        }
+        if (!fields.eof()) {
+            throw std::runtime_error("Malformed agent ID line: " + line);
+        }
+    }
+    return ids;
+}
+
+std::vector<std::uint8_t> SIRSimulation::loadAgeGroups(const std::string& path, int populationSize, int groupCount) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        throw std::runtime_error("Cannot open age group file: " + path);
+    }
+    std::vector<std::uint8_t> groups;
+    groups.reserve(populationSize);
+    std::string line;
+    while (std::getline(in, line)) {
+        std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        long long group = 0;
+        while (fields >> group) {
+            if (group < 0 || group >= groupCount) {
+                throw std::runtime_error("Age group out of range in " + path + ": " + std::to_string(group));
+            }
+            groups.push_back(static_cast<std::uint8_t>(group));
+        }
+        if (!fields.eof()) {
+            throw std::runtime_error("Malformed age group line: " + line);
+        }
+    }
+    if (groups.size() != static_cast<std::size_t>(populationSize)) {
+        throw std::runtime_error("Age group file must list one group per agent: " + path);
+    }
+    return groups;
+}
+
+void SIRSimulation::addIntervention(std::unique_ptr<Intervention> intervention) {
+    interventions.push_back(std::move(intervention));
+}
+
+void SIRSimulation::addStoppingCriterion(std::unique_ptr<StoppingCriterion> criterion) {
+    stoppingCriteria.push_back(std::move(criterion));
+}
+
+void SIRSimulation::applyInterventions() {
+    for (const std::unique_ptr<Intervention>& intervention : interventions) {
+        intervention->apply(*model);
+    }
+}
+
+EpidemicSnapshot SIRSimulation::takeSnapshot(double elapsedSeconds) const {
+    EpidemicSnapshot snapshot;
+    snapshot.day = model->getCurrentDay();
+    snapshot.populationSize = config.populationSize;
+    snapshot.susceptible = model->getSusceptibleCount();
+    snapshot.exposed = model->getExposedCount();
+    snapshot.infected = model->getInfectedCount();
+    snapshot.recovered = model->getRecoveredCount();
+    snapshot.vaccinated = campaign != nullptr ? campaign->getVaccinatedCount() : 0;
+    snapshot.cumulativeInfections = model->getCumulativeInfections();
+    snapshot.elapsedSeconds = elapsedSeconds;
+    return snapshot;
+}
+
+bool SIRSimulation::endOfDay(double elapsedSeconds) {
+    const EpidemicSnapshot snapshot = takeSnapshot(elapsedSeconds);
+    statistics.observe(snapshot);
+    if (dailyQuantiles != nullptr) {
+        dailyQuantiles->observe(snapshot, statistics.getIncidence());
+    }
+    bool stop = false;
+    for (const std::unique_ptr<StoppingCriterion>& criterion : stoppingCriteria) {
+        if (criterion->shouldStop(snapshot) && !stop) {
+            stop = true;
+            stopReason = &criterion->getReason();
+        }
+    }
+    return stop;
 }
 
 void SIRSimulation::initializeSimulation() {
-    // Introduce initial infections
-    for (int i = 0; i < config.initialInfections; i++) {
-        population.infectRandomPerson();
+    // Introduce initial infections: the configured IDs, or exactly
+    // initialInfections distinct random individuals
+    if (!initialInfectionIds.empty()) {
+        model->infectPeople(initialInfectionIds);
+    } else {
+        model->infectRandomPeople(config.initialInfections);
+    }
+    const EpidemicSnapshot snapshot = takeSnapshot(0.0);
+    statistics.observe(snapshot);
+    if (dailyQuantiles != nullptr) {
+        dailyQuantiles->observe(snapshot, statistics.getIncidence());
     }
+    for (const std::unique_ptr<StoppingCriterion>& criterion : stoppingCriteria) {
+        criterion->start(snapshot);
+    }
+    stopReason = &DAY_LIMIT_REASON;
 }
 
 void SIRSimulation::outputDailyStats(int day) const {
     std::cout << "Day " << std::setw(3) << day << ": "
-              << "S=" << std::setw(4) << population.getSusceptibleCount() << ", "
-              << "I=" << std::setw(4) << population.getInfectedCount() << ", "
-              << "R=" << std::setw(4) << population.getRecoveredCount() << std::endl;
+              << "S=" << std::setw(4) << model->getSusceptibleCount() << ", ";
+    if (config.latentDays > 0) {
+        std::cout << "E=" << std::setw(4) << model->getExposedCount() << ", ";
+    }
+    std::cout << "I=" << std::setw(4) << model->getInfectedCount() << ", "
+              << "R=" << std::setw(4) << model->getRecoveredCount();
+    if (config.vaccinatedCompartment) {
+        std::cout << ", V=" << std::setw(4) << model->getVaccinatedCount();
+    }
+    std::cout << ", new=" << std::setw(4) << statistics.getIncidence();
+    if (!std::isnan(statistics.getReproductionNumber())) {
+        std::cout << ", R_t=" << std::fixed << std::setprecision(2) << statistics.getReproductionNumber();
+    }
+    if (scheduler != nullptr) {
+        // Parameters that were in force for the day just simulated
+        const TransmissionParameters& values = scheduler->getCurrentValues();
+        std::cout << "  (p=" << std::fixed << std::setprecision(3) << values.infectionProbability
+                  << ", contacts=" << std::setprecision(1) << values.contactsPerDay << ")";
+    }
+    std::cout << std::endl;
+}
+
+int SIRSimulation::runReplicate() {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    initializeSimulation();
+    int day = 0;
+    while (day < config.simulationDays) {
+        applyInterventions();
+        model->simulateOneDay();
+        day++;
+        if (endOfDay(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count())) {
+            break;
+        }
+    }
+    if (dailyQuantiles != nullptr) {
+        dailyQuantiles->finishReplicate();
+    }
+    return day;
+}
+
+DailyQuantiles SIRSimulation::runEnsemble(const SimulationConfig& config, int replicates, int threads, int k) {
+    if (replicates < 1) {
+        throw std::invalid_argument("An ensemble needs at least one replicate");
+    }
+    SimulationConfig shared = config;
+    shared.seed = config.seed != 0 ? config.seed : std::random_device{}();
+    if (shared.seed == 0) {
+        shared.seed = 1;
+    }
+    shared.threads = 1;
+    // Every worker shares the run seed (per-agent rates, vaccination order); replicate r gets stream 4 + r
+    auto replicateSeed = [&shared](std::size_t r) {
+        const unsigned int seed = static_cast<unsigned int>(streamSeed(shared.seed, 4 + r));
+        return seed != 0 ? seed : 1u;
+    };
+    
+    MergeSlot<DailyQuantiles> combined;
+    const int workers = std::min(resolveThreadCount(threads), replicates);
+    std::vector<std::exception_ptr> errors(static_cast<std::size_t>(workers));
+    parallelFor(static_cast<std::size_t>(replicates), workers, [&](std::size_t begin, std::size_t end, int worker) {
+        // Workers cannot throw: the first error is rethrown after the join
+        try {
+            SIRSimulation simulation(shared);
+            std::unique_ptr<DailyQuantiles> partial(
+                new DailyQuantiles(shared.simulationDays, k, streamSeed(shared.seed, ~std::uint64_t(worker))));
+            simulation.setDailyQuantiles(partial.get());
+            for (std::size_t r = begin; r < end; ++r) {
+                simulation.reset(replicateSeed(r));
+                simulation.runReplicate();
+            }
+            combined.publish(std::move(partial));
+        } catch (...) {
+            errors[worker] = std::current_exception();
+        }
+    });
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return std::move(*combined.take());
+}
+
+std::vector<RunOutcome> SIRSimulation::runBatch(const SimulationConfig& config, std::size_t runs, int threads) {
+    if (!config.isValid()) {
+        throw std::invalid_argument("Invalid simulation configuration: " + config.toString());
+    }
+    const bool plainSir = config.engine == SimulationEngine::Agent && config.contactNetworkFile.empty() &&
+                          config.contactMatrixFile.empty() && config.initialInfectionFile.empty() &&
+                          config.latentDays == 0 && config.immunityDays == 0 && config.vaccinationDosesPerDay == 0 &&
+                          config.infectiousnessDispersion == 0.0 && config.susceptibilityDispersion == 0.0 &&
+                          config.parameterSchedule.empty();
+    const bool extinctionOnly = config.stopAttackRate == 0.0 && config.stopPrevalence == 0.0 &&
+                                config.stopPeakDecline == 0.0 && config.stopWallSeconds == 0.0;
+    if (!plainSir || !extinctionOnly || config.infectionDuration > BatchPopulation::MAX_DURATION) {
+        throw std::invalid_argument("Batched runs support the plain agent SIR model only (homogeneous "
+                                    "mixing, extinction as the only stopping rule): " + config.toString());
+    }
+    const std::uint64_t seed = config.seed != 0 ? config.seed : std::random_device{}();
+
+    BatchPopulation batch(config.populationSize);
+    batch.setInfectionProbability(config.infectionProbability);
+    batch.setContactsPerDay(config.contactsPerDay);
+    batch.setInfectionDuration(config.infectionDuration);
+    std::vector<RunOutcome> outcomes;
+    batch.run(config.initialInfections, config.simulationDays, seed, runs, outcomes, threads);
+    return outcomes;
+}
+
+void SIRSimulation::reset(unsigned int seed) {
+    model->reset(seed != 0 ? seed : std::random_device{}());
+    for (const std::unique_ptr<Intervention>& intervention : interventions) {
+        intervention->reset();
+    }
+    for (const std::unique_ptr<StoppingCriterion>& criterion : stoppingCriteria) {
+        criterion->reset();
+    }
+    stopReason = &NO_STOP_REASON;
+    statistics.reset();
+    timeToFirstDay = 0.0;
 }
 
 void SIRSimulation::runSimulation() {
@@ -81,61 +610,75 @@ void SIRSimulation::runSimulation() {
     std::cout << std::endl;
     
     // Initialize with initial infections
+    const std::chrono::steady_clock::time_point runStart = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point start = runStart;
     initializeSimulation();
+    double seedingSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     
     // Output initial state (day 0)
     outputDailyStats(0);
     
     // Run simulation for specified number of days
     for (int day = 1; day <= config.simulationDays; day++) {
-        population.simulateOneDay();
+        start = std::chrono::steady_clock::now();
+        applyInterventions();
+        model->simulateOneDay();
+        if (day == 1) {
+            timeToFirstDay = constructionSeconds + seedingSeconds +
+                             std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        const bool stop = endOfDay(std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count());
         outputDailyStats(day);
         
-        // Early termination if no more infected individuals
-        if (population.getInfectedCount() == 0) {
+        // Early termination: extinction or a configured criterion
+        if (stop) {
             std::cout << std::endl;
-            std::cout << "*** Epidemic ended on day " << day << " ***" << std::endl;
+            std::cout << "*** Stopped on day " << day << ": " << *stopReason << " ***" << std::endl;
             break;
         }
     }
     
+    if (dailyQuantiles != nullptr) {
+        dailyQuantiles->finishReplicate();
+    }
+    
     // Final summary
     std::cout << std::endl;
     std::cout << "=== Final Statistics ===" << std::endl;
-    std::cout << "Susceptible: " << population.getSusceptibleCount() 
+    std::cout << "Stop Reason: " << *stopReason << " (day " << model->getCurrentDay() << ")" << std::endl;
+    std::cout << "Susceptible: " << model->getSusceptibleCount() 
               << " (" << std::fixed << std::setprecision(1) 
-              << (100.0 * population.getSusceptibleCount() / config.populationSize) << "%)" << std::endl;
-    std::cout << "Recovered: " << population.getRecoveredCount() 
+              << (100.0 * model->getSusceptibleCount() / config.populationSize) << "%)" << std::endl;
+    std::cout << "Recovered: " << model->getRecoveredCount() 
               << " (" << std::fixed << std::setprecision(1) 
-              << (100.0 * population.getRecoveredCount() / config.populationSize) << "%)" << std::endl;
-    std::cout << "Total Affected: " << (config.populationSize - population.getSusceptibleCount())
+              << (100.0 * model->getRecoveredCount() / config.populationSize) << "%)" << std::endl;
+    // Vaccinated individuals left S without being infected
+    const std::int64_t vaccinated = campaign != nullptr ? campaign->getVaccinatedCount() : 0;
+    const std::int64_t affected = std::max<std::int64_t>(
+        0, static_cast<std::int64_t>(config.populationSize) - model->getSusceptibleCount() - vaccinated);
+    if (campaign != nullptr) {
+        std::cout << "Vaccinated: " << vaccinated 
+                  << " (" << std::fixed << std::setprecision(1) 
+                  << (100.0 * vaccinated / config.populationSize) << "%, "
+                  << campaign->getDosesGiven() << " doses)" << std::endl;
+    }
+    std::cout << "Total Affected: " << affected
               << " (" << std::fixed << std::setprecision(1) 
-              << (100.0 * (config.populationSize - population.getSusceptibleCount()) / config.populationSize) << "%)" << std::endl;
+              << (100.0 * affected / config.populationSize) << "%)" << std::endl;
     std::cout << "Attack Rate: " << std::fixed << std::setprecision(1) 
-              << (100.0 * (config.populationSize - population.getSusceptibleCount()) / config.populationSize) << "%" << std::endl;
-}
-
-int main() {
-    try {
-        // Create simulation configuration with default parameters
-        SimulationConfig config;
-        
-        // Optionally customize parameters for different scenarios
-        // Example: config.populationSize = 5000;
-        // Example: config.infectionProbability = 0.3f;
-        
-        std::cout << "Initializing simulation with configuration:" << std::endl;
-        std::cout << config.toString() << std::endl;
+              << (100.0 * affected / config.populationSize) << "%" << std::endl;
+    std::cout << statistics.toString(config.populationSize);
+    if (population != nullptr && population->hasAgeStructure()) {
+        std::vector<int> susceptibleByGroup;
+        population->getAgeGroupCounts(HealthState::Susceptible, susceptibleByGroup);
+        std::cout << "Susceptible by Age Group:";
+        for (std::size_t g = 0; g < susceptibleByGroup.size(); ++g) {
+            int members = population->getAgeGroupSize(static_cast<int>(g));
+            std::cout << (g == 0 ? " " : ", ") << g << ": " << std::fixed << std::setprecision(1)
+                      << (members > 0 ? 100.0 * susceptibleByGroup[g] / members : 0.0) << "%";
+        }
         std::cout << std::endl;
-        
-        // Create and run simulation
-        SIRSimulation simulation(config);
-        simulation.runSimulation();
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error: " << e.what() << std::endl;
-        return 1;
     }
-    
-    return 0;
+    std::cout << "Time to First Day: " << std::fixed << std::setprecision(2) << 1e3 * timeToFirstDay
+              << " ms (construction " << 1e3 * constructionSeconds << " ms)" << std::endl;
 }
@@ -0,0 +1,75 @@
+/**
+ * @file Sampling.h
+ * @brief Exact sampling of distinct susceptible agents for batch seeding
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * Shared by the engines that keep a byte-per-agent state column, so that
+ * Population and MetapopulationModel seed with the same algorithms and differ
+ * only in their random number generator.
+ */
+
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+#include "Person.h"
+#include <cstdint>
+
+/**
+ * @brief Picks exactly count distinct susceptible agents and hands each to infect
+ *
+ * On an all-susceptible column Floyd's algorithm draws the sample in
+ * O(count) time, using the state column itself as the membership set.
+ * Otherwise small batches (at most a quarter of the susceptibles) redraw
+ * until they hit a susceptible agent, and larger ones use one
+ * selection-sampling pass (Knuth's Algorithm S) over the susceptible agents.
+ *
+ * infect(i) must make agent i non-susceptible, since the later draws read
+ * the column to avoid picking it again.
+ *
+ * @param states State column (index = array position)
+ * @param size Number of agents in the column
+ * @param susceptible Agents currently susceptible
+ * @param count Agents to pick (0 <= count <= susceptible, checked by the caller)
+ * @param draws Draw source: below(n) gives a uniform integer in [0, n), unit() a double in [0, 1)
+ * @param infect Callable taking the std::uint32_t index of each picked agent
+ */
+template <typename Draws, typename Infect>
+void sampleSusceptible(const std::uint8_t* states, int size, int susceptible, int count, Draws& draws,
+                       Infect infect) {
+    const std::uint8_t code = static_cast<std::uint8_t>(HealthState::Susceptible);
+    const std::uint32_t n = static_cast<std::uint32_t>(size);
+    if (susceptible == size) {
+        // Floyd: for j = N-k..N-1 take a uniform t in [0, j], or j itself if t was already taken
+        for (std::uint32_t j = n - static_cast<std::uint32_t>(count); j < n; ++j) {
+            const std::uint32_t t = draws.below(j + 1);
+            infect(states[t] == code ? t : j);
+        }
+        return;
+    }
+    if (4LL * count <= susceptible) {
+        // Few relative to the susceptibles: redraw until a susceptible agent is hit
+        for (int i = 0; i < count; ++i) {
+            std::uint32_t t;
+            do {
+                t = draws.below(n);
+            } while (states[t] != code);
+            infect(t);
+        }
+        return;
+    }
+    int needed = count;
+    int remaining = susceptible;
+    for (std::uint32_t i = 0; needed > 0; ++i) {
+        if (states[i] != code) {
+            continue;
+        }
+        if (draws.unit() * remaining < needed) {
+            infect(i);
+            needed--;
+        }
+        remaining--;
+    }
+}
+
+#endif // SAMPLING_H
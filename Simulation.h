@@ -12,6 +12,28 @@
 #define SIMULATION_H
 
 #include "Population.h"
+#include "Intervention.h"
+#include "StoppingCriterion.h"
+#include "QuantileSketch.h"
+#include "BatchPopulation.h"
+#include "GraphOrdering.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Simulation engine used to advance the epidemic
+ */
+enum class SimulationEngine {
+    Agent,      ///< Individual-based day-step model (Population)
+    Gillespie,  ///< Exact continuous-time SSA on aggregate counts (GillespieModel)
+    TauLeap,    ///< Adaptive tau-leaping on aggregate counts (TauLeapModel)
+    ODE,        ///< Deterministic mean-field RK45 integration (OdeModel)
+    Hybrid,     ///< Agents at low prevalence, chain-binomial cohorts at high prevalence (HybridModel)
+    Metapopulation  ///< Agents in patches with inter-patch mobility (MetapopulationModel)
+};
 
 /**
  * @brief Configuration structure for SIR epidemic simulation parameters
@@ -29,7 +51,36 @@ struct SimulationConfig {
     int simulationDays;         ///< Number of days to simulate (must be > 0)
     float infectionProbability; ///< Probability of infection upon contact (0.0 <= p <= 1.0)
     int contactsPerDay;         ///< Number of contacts per infected person per day (must be >= 0)
-    int infectionDuration;      ///< Duration of infection in days (must be > 0)
+    int infectionDuration;      ///< Duration of infection in days (0 < infectionDuration <= MAX_INFECTION_DURATION)
+    SimulationEngine engine;    ///< Engine used to advance the epidemic
+    unsigned int seed;          ///< Random seed (0 draws a fresh seed from std::random_device)
+    double hybridSwitchPrevalence;  ///< Hybrid engine: I/N at which agents are aggregated (0 < p <= 1)
+    double hybridReturnPrevalence;  ///< Hybrid engine: I/N below which agents return in the tail (0 <= p < switch)
+    std::string contactNetworkFile; ///< Agent engine: edge list restricting contacts (empty = homogeneous mixing)
+    NodeOrdering networkOrdering;   ///< Agent relabeling applied to the contact network for cache locality
+    int patchCount;                 ///< Metapopulation engine: equal-size patches (1..populationSize)
+    double patchMobility;           ///< Metapopulation engine: fraction of contacts in grid-neighbor patches
+    std::string mobilityFile;       ///< Metapopulation engine: "source destination fraction" lines (overrides the grid)
+    PagePolicy pagePolicy;          ///< Agent engines: page backing of the agent columns (falls back if unavailable)
+    int threads;                    ///< Worker threads for bulk fills and parallel engines (<= 0 = hardware)
+    std::string initialInfectionFile;   ///< Agent, hybrid and metapopulation engines: IDs infected on day 0 (overrides initialInfections)
+    int latentDays;                 ///< Agent engine: exposed (non-infectious) days before infectiousness (0 = SIR, no E stage)
+    int immunityDays;               ///< Agent engine: days until recovered individuals are susceptible again (0 = lifelong)
+    int vaccinationDosesPerDay;     ///< Agent and metapopulation engines: doses per day (0 = no vaccination campaign)
+    int vaccinationStartDay;        ///< Day the first doses are given
+    std::string vaccinationPriorityFile;    ///< Agent IDs in vaccination order (empty = uniformly random order)
+    bool vaccinatedCompartment;     ///< Agent engine: vaccinate into a separate V compartment instead of R
+    std::string contactMatrixFile;  ///< Agent engine: age-by-age contacts per day (empty = no age structure; overrides contactsPerDay)
+    std::string ageGroupFile;       ///< Age group of each agent ID (empty = equal contiguous groups; needs contactMatrixFile)
+    double infectiousnessDispersion;    ///< Agent engine: gamma shape k of per-agent infectiousness (0 = equal; small k = superspreading)
+    double susceptibilityDispersion;    ///< Agent engine: gamma shape k of per-agent susceptibility (0 = equal)
+    ParameterSchedule parameterSchedule;    ///< Day-indexed infectionProbability / contactsPerDay changes (empty = fixed)
+    double stopAttackRate;          ///< Stop once this fraction of the population was infected (0 = off)
+    double stopPrevalence;          ///< Stop when (I + E) / N stays below this for stopPrevalenceDays (0 = off)
+    int stopPrevalenceDays;         ///< Consecutive days below stopPrevalence (>= 1)
+    double stopPeakDecline;         ///< Stop once I has fallen this fraction below its peak (0 = off; < 1)
+    int stopPeakMinimum;            ///< Smallest infected count accepted as a peak by stopPeakDecline
+    double stopWallSeconds;         ///< Stop once a run has taken this many seconds (0 = off)
     
     /**
      * @brief Default constructor with epidemiologically reasonable default values
@@ -41,10 +92,19 @@ struct SimulationConfig {
      * - Transmission probability: 50% per contact
      * - Contact rate: 6 contacts per day per infected individual
      * - Infectious period: 5 days
+     * - Agent-based engine with a non-deterministic seed
      */
     SimulationConfig() 
         : populationSize(1000), initialInfections(5), simulationDays(90),
-          infectionProbability(0.5f), contactsPerDay(6), infectionDuration(5) {}
+          infectionProbability(0.5f), contactsPerDay(6), infectionDuration(5),
+          engine(SimulationEngine::Agent), seed(0),
+          hybridSwitchPrevalence(0.01), hybridReturnPrevalence(0.001),
+          networkOrdering(NodeOrdering::None), patchCount(1), patchMobility(0.05),
+          pagePolicy(PagePolicy::Default), threads(0), latentDays(0), immunityDays(0),
+          vaccinationDosesPerDay(0), vaccinationStartDay(0), vaccinatedCompartment(false),
+          infectiousnessDispersion(0.0), susceptibilityDispersion(0.0), stopAttackRate(0.0),
+          stopPrevalence(0.0), stopPrevalenceDays(7), stopPeakDecline(0.0), stopPeakMinimum(0),
+          stopWallSeconds(0.0) {}
     
     /**
      * @brief Parameterized constructor with validation
@@ -54,7 +114,7 @@ struct SimulationConfig {
      * @param simDays Simulation duration in days (must be > 0)
      * @param infProb Infection probability per contact (must be 0.0-1.0)
      * @param contacts Daily contacts per infected person (must be >= 0)
-     * @param duration Infection duration in days (must be > 0)
+     * @param duration Infection duration in days (must be 1..MAX_INFECTION_DURATION)
      * @throws std::invalid_argument if any parameter is invalid
      */
     SimulationConfig(int popSize, int initInfections, int simDays, 
@@ -68,29 +128,101 @@ struct SimulationConfig {
      */
     bool isValid() const;
     
+    /**
+     * @brief Gets the mean-field transmission rate used by the aggregate engines
+     * 
+     * @return beta = contactsPerDay * infectionProbability (per day)
+     */
+    double getInfectionRate() const { return static_cast<double>(contactsPerDay) * infectionProbability; }
+    
+    /**
+     * @brief Gets the mean-field recovery rate used by the aggregate engines
+     * 
+     * @return gamma = 1 / infectionDuration (per day)
+     */
+    double getRecoveryRate() const { return 1.0 / infectionDuration; }
+    
     /**
      * @brief Gets a string description of the configuration
      * 
      * @return Formatted string with all parameter values
      */
     std::string toString() const;
+    
+    /**
+     * @brief Gets the agent storage options derived from pagePolicy and threads
+     */
+    StorageOptions getStorageOptions() const;
+    
+    /**
+     * @brief Gets the disease course: SIR, SIRS, SEIR or SEIRS from latentDays and immunityDays
+     * 
+     * With vaccinatedCompartment a lifelong V compartment is appended.
+     */
+    CompartmentModel getCompartmentModel() const;
 };
 
+/**
+ * @brief Gets a printable name for a simulation engine
+ */
+const char* simulationEngineName(SimulationEngine engine);
+
 /**
  * @brief Main simulation runner class
  * 
- * Orchestrates the SIR epidemic simulation with configurable parameters
+ * Orchestrates the SIR epidemic simulation with configurable parameters.
+ * The engine is chosen by SimulationConfig::engine; every engine produces
+ * the same daily trajectory output.
  */
 class SIRSimulation {
 private:
-    SimulationConfig config;   ///< Simulation configuration
-    Population population;     ///< Population being simulated
+    SimulationConfig config;                ///< Simulation configuration
+    std::unique_ptr<EpidemicModel> model;   ///< Engine selected by config.engine
+    Population* population;                 ///< Agent population (nullptr for aggregate engines)
+    double constructionSeconds;             ///< Wall time spent building the engine
+    double timeToFirstDay;                  ///< Construction + seeding + first day (0 until run)
+    std::vector<std::uint32_t> initialInfectionIds;   ///< IDs from config.initialInfectionFile (empty = random seeding)
+    std::vector<std::unique_ptr<Intervention>> interventions;   ///< Applied before every simulated day
+    VaccinationCampaign* campaign;          ///< Campaign from config.vaccinationDosesPerDay (nullptr if none)
+    ParameterScheduler* scheduler;          ///< Applies config.parameterSchedule (nullptr if empty)
+    std::vector<std::unique_ptr<StoppingCriterion>> stoppingCriteria;   ///< Checked after every simulated day
+    const std::string* stopReason;          ///< Why the last run stopped: a criterion's reason or a constant below
+    
+    static const std::string NO_STOP_REASON;     ///< Stop reason before the first run (empty)
+    static const std::string DAY_LIMIT_REASON;   ///< Stop reason when no criterion was met
+    EpidemicStatistics statistics;          ///< Summary of the current run, updated every day
+    DailyQuantiles* dailyQuantiles;         ///< Ensemble summary fed every day (nullptr = none; not owned)
     
     /**
      * @brief Initializes the simulation with initial infections
+     * 
+     * Records day 0 in the statistics and presets the stop reason to the day limit.
      */
     void initializeSimulation();
     
+    /**
+     * @brief Applies every intervention to the engine before the next day
+     */
+    void applyInterventions();
+    
+    /**
+     * @brief Gets the engine's counts at the end of the current day
+     * 
+     * @param elapsedSeconds Wall time since the run started
+     */
+    EpidemicSnapshot takeSnapshot(double elapsedSeconds) const;
+    
+    /**
+     * @brief Records a simulated day in the statistics and checks the stopping criteria
+     * 
+     * Every criterion sees the day (so running state such as a peak stays
+     * current); the first one met sets stopReason.
+     * 
+     * @param elapsedSeconds Wall time since the run started
+     * @return true if the run should stop
+     */
+    bool endOfDay(double elapsedSeconds);
+    
     /**
      * @brief Outputs the current state of the simulation
      * 
@@ -106,6 +238,64 @@ public:
      */
     explicit SIRSimulation(const SimulationConfig& simConfig);
     
+    /**
+     * @brief Constructor with a prebuilt contact network (e.g. from NetworkGenerator)
+     * 
+     * @param simConfig Simulation configuration parameters (agent engine)
+     * @param network Network with one node per individual
+     * @throws std::invalid_argument if the engine is not agent-based or the sizes differ
+     */
+    SIRSimulation(const SimulationConfig& simConfig, std::shared_ptr<const ContactNetwork> network);
+    
+    /**
+     * @brief Loads a list of agent IDs
+     * 
+     * The file holds whitespace-separated IDs; lines starting with '#' are
+     * comments.
+     * 
+     * @param path Text file
+     * @param populationSize Number of agents (every ID must be below it)
+     * @return IDs in file order
+     * @throws std::runtime_error if the file cannot be read, is malformed or an ID is out of range
+     */
+    static std::vector<std::uint32_t> loadAgentIds(const std::string& path, int populationSize);
+    
+    /**
+     * @brief Loads the age group of every agent
+     * 
+     * The file holds one whitespace-separated group per agent, in agent ID
+     * order; lines starting with '#' are comments.
+     * 
+     * @param path Text file
+     * @param populationSize Number of agents (exactly this many groups are expected)
+     * @param groupCount Number of age groups (every group must be below it)
+     * @return Age group of each agent ID
+     * @throws std::runtime_error if the file cannot be read, is malformed, has the
+     *         wrong length or a group is out of range
+     */
+    static std::vector<std::uint8_t> loadAgeGroups(const std::string& path, int populationSize, int groupCount);
+    
+    /**
+     * @brief Adds an intervention applied before every simulated day
+     * 
+     * Interventions run in the order they were added, after the one built
+     * from the configuration; reset() rewinds them.
+     * 
+     * @param intervention Intervention owned by the simulation from now on
+     */
+    void addIntervention(std::unique_ptr<Intervention> intervention);
+    
+    /**
+     * @brief Adds a criterion that can end a run before config.simulationDays
+     * 
+     * Criteria are checked after every day in the order they were added,
+     * after extinction and the ones built from the configuration; reset()
+     * rewinds them.
+     * 
+     * @param criterion Criterion owned by the simulation from now on
+     */
+    void addStoppingCriterion(std::unique_ptr<StoppingCriterion> criterion);
+    
     /**
      * @brief Runs the complete simulation
      * 
@@ -114,12 +304,132 @@ public:
      */
     void runSimulation();
     
+    /**
+     * @brief Runs one replicate without output
+     * 
+     * Seeds the initial infections and simulates up to config.simulationDays
+     * days, stopping early when a stopping criterion is met (as
+     * runSimulation() does; getStopReason() tells which).
+     * 
+     * @return Number of days simulated
+     */
+    int runReplicate();
+    
+    /**
+     * @brief Prepares the next replicate in place
+     * 
+     * Resets the engine to an all-susceptible day 0 with its parameters,
+     * contact network and buffers kept, so an ensemble loop of reset() and
+     * runReplicate() reuses every allocation of the first replicate.
+     * 
+     * @param seed Seed of the next replicate (0 draws one from std::random_device)
+     */
+    void reset(unsigned int seed);
+    
     /**
      * @brief Gets the current population statistics
      * 
      * @return Reference to the population object
+     * @throws std::logic_error if the configured engine is not agent-based
+     */
+    const Population& getPopulation() const;
+    
+    /**
+     * @brief Gets the engine driving the simulation
+     * 
+     * @return Reference to the epidemic model (valid for every engine)
+     */
+    const EpidemicModel& getModel() const { return *model; }
+    
+    /**
+     * @brief Gets the startup latency of the last run
+     * 
+     * @return Seconds spent constructing the engine, seeding the initial
+     *         infections and simulating day 1 (0 before runSimulation())
+     */
+    double getTimeToFirstDay() const { return timeToFirstDay; }
+    
+    /**
+     * @brief Gets the vaccination campaign built from the configuration
+     * 
+     * @return The campaign, or nullptr if config.vaccinationDosesPerDay is 0
+     */
+    const VaccinationCampaign* getVaccinationCampaign() const { return campaign; }
+    
+    /**
+     * @brief Gets the scheduler applying config.parameterSchedule
+     * 
+     * Its position is the schedule state to record alongside a saved day.
+     * 
+     * @return The scheduler, or nullptr if the schedule is empty
+     */
+    const ParameterScheduler* getParameterScheduler() const { return scheduler; }
+    
+    /**
+     * @brief Gets why the last run or replicate stopped
+     * 
+     * @return The met criterion's reason, "day limit reached", or an empty
+     *         string before the first run
+     */
+    const std::string& getStopReason() const { return *stopReason; }
+    
+    /**
+     * @brief Gets the summary statistics of the current or last run
+     * 
+     * Updated after seeding and after every simulated day of runSimulation()
+     * and runReplicate(); reset() clears it.
+     */
+    const EpidemicStatistics& getStatistics() const { return statistics; }
+    
+    /**
+     * @brief Feeds every following run's daily counts into ensemble quantiles
+     * 
+     * Each run or replicate adds one trajectory: its days as they are
+     * simulated, then its final state held to the horizon.
+     * 
+     * @param quantiles Summary to fill (not owned; nullptr stops feeding)
+     */
+    void setDailyQuantiles(DailyQuantiles* quantiles) { dailyQuantiles = quantiles; }
+    
+    /**
+     * @brief Runs an ensemble and summarizes it by per-day quantiles
+     * 
+     * Replicates are split over worker threads; each builds one engine (with
+     * config.threads forced to 1), runs its share with reset() in between and
+     * fills its own DailyQuantiles, and the partial summaries are merged
+     * through a lock-free MergeSlot. Replicate r uses a seed derived from
+     * config.seed and r, so the replicates do not depend on the thread count;
+     * the sketches' randomized compaction and merge order do, within their
+     * error bound.
+     * 
+     * @param config Configuration of every replicate (seed 0 draws a base seed)
+     * @param replicates Number of replicates (> 0)
+     * @param threads Worker threads (<= 0 selects the hardware concurrency)
+     * @param k Sketch top-level capacity
+     * @return Quantiles of days 0..config.simulationDays
+     * @throws std::invalid_argument if the configuration or replicates is invalid
+     */
+    static DailyQuantiles runEnsemble(const SimulationConfig& config, int replicates, int threads = 0,
+                                      int k = QuantileSketch::DEFAULT_K);
+    
+    /**
+     * @brief Runs many small replicates on the lane-batched engine
+     * 
+     * For sweeps of many runs of a small population, where the per-run cost
+     * of an engine and of this driver dominates. BatchPopulation simulates
+     * the plain agent SIR model (homogeneous mixing, extinction and the day
+     * limit as the only stopping rules), so configurations using anything
+     * else are rejected rather than silently simplified. Run r uses stream r
+     * of config.seed; outcomes do not depend on the thread count.
+     * 
+     * @param config Configuration of every run (seed 0 draws a base seed)
+     * @param runs Number of runs
+     * @param threads Worker threads (<= 0 selects the hardware concurrency)
+     * @return The outcome of every run, in run order
+     * @throws std::invalid_argument if the configuration is invalid or uses a
+     *         feature the batched engine does not model
      */
-    const Population& getPopulation() const { return population; }
+    static std::vector<RunOutcome> runBatch(const SimulationConfig& config, std::size_t runs, int threads = 0);
 };
 
 #endif // SIMULATION_H
@@ -0,0 +1,377 @@
+/**
+ * @file StateKernels.cpp
+ * @brief Scalar, AVX2 and AVX-512BW implementations of the state kernels
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "StateKernels.h"
+#include "Person.h"
+#include <atomic>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIR_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const std::uint8_t SUSCEPTIBLE = static_cast<std::uint8_t>(HealthState::Susceptible);
+const std::uint8_t INFECTED = static_cast<std::uint8_t>(HealthState::Infected);
+
+static_assert(static_cast<int>(HealthState::Recovered) == static_cast<int>(HealthState::Infected) + 1,
+              "Recovery is encoded as state + 1");
+
+std::atomic<int> selectedIsa(-1);
+
+/**
+ * @brief Branch-free scalar progression of agents [begin, end), accumulating counts
+ */
+inline void progressRange(std::uint8_t* states, std::uint8_t* daysLeft,
+                          std::size_t begin, std::size_t end, StateCounts& counts) {
+    for (std::size_t i = begin; i < end; ++i) {
+        std::uint8_t infected = states[i] == INFECTED;
+        daysLeft[i] = static_cast<std::uint8_t>(daysLeft[i] - infected);
+        states[i] = static_cast<std::uint8_t>(states[i] + (infected & (daysLeft[i] == 0)));
+        counts.susceptible += states[i] == SUSCEPTIBLE;
+        counts.infected += states[i] == INFECTED;
+    }
+}
+
+inline void countRange(const std::uint8_t* states, std::size_t begin, std::size_t end,
+                       StateCounts& counts) {
+    for (std::size_t i = begin; i < end; ++i) {
+        counts.susceptible += states[i] == SUSCEPTIBLE;
+        counts.infected += states[i] == INFECTED;
+    }
+}
+
+/**
+ * @brief Table-driven scalar progression of agents [begin, end), accumulating per-compartment counts
+ */
+inline void progressCompartmentRange(const TransitionTable& table, std::uint8_t* states, std::uint8_t* daysLeft,
+                                     std::size_t begin, std::size_t end, CompartmentCounts& counts) {
+    for (std::size_t i = begin; i < end; ++i) {
+        std::uint8_t state = states[i];
+        std::uint8_t timed = table.timed[state];
+        std::uint8_t days = static_cast<std::uint8_t>(daysLeft[i] + timed);   // 0xFF adds -1
+        if (timed != 0 && days == 0) {
+            state = table.next[state];
+            days = table.entryDays[state];
+        }
+        states[i] = state;
+        daysLeft[i] = days;
+        counts.counts[state]++;
+    }
+}
+
+/**
+ * @brief Derives the last compartment's count from the total (the vector loops skip counting it)
+ */
+inline void completeCounts(const TransitionTable& table, std::size_t count, CompartmentCounts& counts) {
+    std::int64_t counted = 0;
+    for (int c = 0; c + 1 < table.compartments; ++c) {
+        counted += counts.counts[c];
+    }
+    counts.counts[table.compartments - 1] = static_cast<std::int64_t>(count) - counted;
+}
+
+#ifdef SIR_X86_KERNELS
+
+__attribute__((target("avx2,popcnt")))
+StateCounts progressAndCountStatesAvx2(std::uint8_t* states, std::uint8_t* daysLeft, std::size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    StateCounts counts = {0, 0, 0};
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i state = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states + i));
+        __m256i days = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(daysLeft + i));
+        __m256i infected = _mm256_cmpeq_epi8(state, one);
+        days = _mm256_sub_epi8(days, _mm256_and_si256(infected, one));
+        // Lanes of `done` are 0xFF (-1) where an infection ends, so subtracting advances I -> R
+        __m256i done = _mm256_and_si256(infected, _mm256_cmpeq_epi8(days, zero));
+        state = _mm256_sub_epi8(state, done);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(states + i), state);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(daysLeft + i), days);
+        counts.susceptible += __builtin_popcount(
+            static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(state, zero))));
+        counts.infected += __builtin_popcount(
+            static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(state, one))));
+    }
+    progressRange(states, daysLeft, i, count, counts);
+    counts.recovered = static_cast<std::int64_t>(count) - counts.susceptible - counts.infected;
+    return counts;
+}
+
+// Counting accumulates per-byte matches for up to 255 vectors before widening with
+// SAD, which keeps the loop free of movemask/popcount dependencies.
+__attribute__((target("avx2")))
+StateCounts countStatesAvx2(const std::uint8_t* states, std::size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    __m256i totalSusceptible = zero;
+    __m256i totalInfected = zero;
+    std::size_t i = 0;
+    while (i + 32 <= count) {
+        __m256i blockSusceptible = zero;
+        __m256i blockInfected = zero;
+        for (int v = 0; v < 255 && i + 32 <= count; ++v, i += 32) {
+            __m256i state = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states + i));
+            blockSusceptible = _mm256_sub_epi8(blockSusceptible, _mm256_cmpeq_epi8(state, zero));
+            blockInfected = _mm256_sub_epi8(blockInfected, _mm256_cmpeq_epi8(state, one));
+        }
+        totalSusceptible = _mm256_add_epi64(totalSusceptible, _mm256_sad_epu8(blockSusceptible, zero));
+        totalInfected = _mm256_add_epi64(totalInfected, _mm256_sad_epu8(blockInfected, zero));
+    }
+    alignas(32) std::int64_t lanes[2][4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), totalSusceptible);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), totalInfected);
+    StateCounts counts = {lanes[0][0] + lanes[0][1] + lanes[0][2] + lanes[0][3],
+                          lanes[1][0] + lanes[1][1] + lanes[1][2] + lanes[1][3], 0};
+    countRange(states, i, count, counts);
+    counts.recovered = static_cast<std::int64_t>(count) - counts.susceptible - counts.infected;
+    return counts;
+}
+
+__attribute__((target("avx512bw,popcnt")))
+StateCounts progressAndCountStatesAvx512(std::uint8_t* states, std::uint8_t* daysLeft, std::size_t count) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi8(1);
+    StateCounts counts = {0, 0, 0};
+    std::size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        __m512i state = _mm512_loadu_si512(states + i);
+        __m512i days = _mm512_loadu_si512(daysLeft + i);
+        __mmask64 infected = _mm512_cmpeq_epi8_mask(state, one);
+        days = _mm512_mask_sub_epi8(days, infected, days, one);
+        __mmask64 done = _mm512_mask_cmpeq_epi8_mask(infected, days, zero);
+        state = _mm512_mask_add_epi8(state, done, state, one);
+        _mm512_storeu_si512(states + i, state);
+        _mm512_storeu_si512(daysLeft + i, days);
+        counts.susceptible += __builtin_popcountll(_mm512_cmpeq_epi8_mask(state, zero));
+        counts.infected += __builtin_popcountll(_mm512_cmpeq_epi8_mask(state, one));
+    }
+    progressRange(states, daysLeft, i, count, counts);
+    counts.recovered = static_cast<std::int64_t>(count) - counts.susceptible - counts.infected;
+    return counts;
+}
+
+__attribute__((target("avx512bw")))
+StateCounts countStatesAvx512(const std::uint8_t* states, std::size_t count) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi8(1);
+    __m512i totalSusceptible = zero;
+    __m512i totalInfected = zero;
+    std::size_t i = 0;
+    while (i + 64 <= count) {
+        __m512i blockSusceptible = zero;
+        __m512i blockInfected = zero;
+        for (int v = 0; v < 255 && i + 64 <= count; ++v, i += 64) {
+            __m512i state = _mm512_loadu_si512(states + i);
+            blockSusceptible = _mm512_mask_add_epi8(blockSusceptible, _mm512_cmpeq_epi8_mask(state, zero),
+                                                    blockSusceptible, one);
+            blockInfected = _mm512_mask_add_epi8(blockInfected, _mm512_cmpeq_epi8_mask(state, one),
+                                                 blockInfected, one);
+        }
+        totalSusceptible = _mm512_add_epi64(totalSusceptible, _mm512_sad_epu8(blockSusceptible, zero));
+        totalInfected = _mm512_add_epi64(totalInfected, _mm512_sad_epu8(blockInfected, zero));
+    }
+    alignas(64) std::int64_t lanes[2][8];
+    _mm512_store_si512(lanes[0], totalSusceptible);
+    _mm512_store_si512(lanes[1], totalInfected);
+    StateCounts counts = {0, 0, 0};
+    for (int lane = 0; lane < 8; ++lane) {
+        counts.susceptible += lanes[0][lane];
+        counts.infected += lanes[1][lane];
+    }
+    countRange(states, i, count, counts);
+    counts.recovered = static_cast<std::int64_t>(count) - counts.susceptible - counts.infected;
+    return counts;
+}
+
+// The compartment kernels look up timed/next/entryDays with byte shuffles: state
+// codes are below 16, so one 16-byte table broadcast to every 128-bit lane
+// serves all agents of a register.
+__attribute__((target("avx2,popcnt")))
+CompartmentCounts progressAndCountCompartmentsAvx2(const TransitionTable& table, std::uint8_t* states,
+                                                   std::uint8_t* daysLeft, std::size_t count) {
+    const __m256i timedTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table.timed)));
+    const __m256i nextTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table.next)));
+    const __m256i entryTable =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table.entryDays)));
+    const __m256i zero = _mm256_setzero_si256();
+    const int counted = table.compartments - 1;
+    CompartmentCounts counts = {{0}};
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i state = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states + i));
+        __m256i days = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(daysLeft + i));
+        __m256i timed = _mm256_shuffle_epi8(timedTable, state);
+        days = _mm256_add_epi8(days, timed);
+        __m256i done = _mm256_and_si256(timed, _mm256_cmpeq_epi8(days, zero));
+        __m256i next = _mm256_shuffle_epi8(nextTable, state);
+        state = _mm256_blendv_epi8(state, next, done);
+        days = _mm256_blendv_epi8(days, _mm256_shuffle_epi8(entryTable, next), done);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(states + i), state);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(daysLeft + i), days);
+        for (int c = 0; c < counted; ++c) {
+            counts.counts[c] += __builtin_popcount(static_cast<unsigned>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(state, _mm256_set1_epi8(static_cast<char>(c))))));
+        }
+    }
+    progressCompartmentRange(table, states, daysLeft, i, count, counts);
+    completeCounts(table, count, counts);
+    return counts;
+}
+
+__attribute__((target("avx512bw,popcnt")))
+CompartmentCounts progressAndCountCompartmentsAvx512(const TransitionTable& table, std::uint8_t* states,
+                                                     std::uint8_t* daysLeft, std::size_t count) {
+    alignas(64) std::uint8_t lanes[3][64];
+    for (int lane = 0; lane < 4; ++lane) {
+        std::memcpy(lanes[0] + MAX_COMPARTMENTS * lane, table.timed, MAX_COMPARTMENTS);
+        std::memcpy(lanes[1] + MAX_COMPARTMENTS * lane, table.next, MAX_COMPARTMENTS);
+        std::memcpy(lanes[2] + MAX_COMPARTMENTS * lane, table.entryDays, MAX_COMPARTMENTS);
+    }
+    const __m512i timedTable = _mm512_load_si512(lanes[0]);
+    const __m512i nextTable = _mm512_load_si512(lanes[1]);
+    const __m512i entryTable = _mm512_load_si512(lanes[2]);
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi8(1);
+    const int counted = table.compartments - 1;
+    CompartmentCounts counts = {{0}};
+    std::size_t i = 0;
+    for (; i + 64 <= count; i += 64) {
+        __m512i state = _mm512_loadu_si512(states + i);
+        __m512i days = _mm512_loadu_si512(daysLeft + i);
+        __mmask64 timed = _mm512_test_epi8_mask(_mm512_shuffle_epi8(timedTable, state), one);
+        days = _mm512_mask_sub_epi8(days, timed, days, one);
+        __mmask64 done = _mm512_mask_cmpeq_epi8_mask(timed, days, zero);
+        __m512i next = _mm512_shuffle_epi8(nextTable, state);
+        state = _mm512_mask_mov_epi8(state, done, next);
+        days = _mm512_mask_mov_epi8(days, done, _mm512_shuffle_epi8(entryTable, next));
+        _mm512_storeu_si512(states + i, state);
+        _mm512_storeu_si512(daysLeft + i, days);
+        for (int c = 0; c < counted; ++c) {
+            counts.counts[c] +=
+                __builtin_popcountll(_mm512_cmpeq_epi8_mask(state, _mm512_set1_epi8(static_cast<char>(c))));
+        }
+    }
+    progressCompartmentRange(table, states, daysLeft, i, count, counts);
+    completeCounts(table, count, counts);
+    return counts;
+}
+
+#endif // SIR_X86_KERNELS
+
+} // namespace
+
+KernelIsa detectKernelIsa() {
+#ifdef SIR_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) {
+        return KernelIsa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return KernelIsa::AVX2;
+    }
+#endif
+    return KernelIsa::Scalar;
+}
+
+KernelIsa getKernelIsa() {
+    int isa = selectedIsa.load(std::memory_order_relaxed);
+    if (isa < 0) {
+        isa = static_cast<int>(detectKernelIsa());
+        selectedIsa.store(isa, std::memory_order_relaxed);
+    }
+    return static_cast<KernelIsa>(isa);
+}
+
+KernelIsa setKernelIsa(KernelIsa isa) {
+    KernelIsa best = detectKernelIsa();
+    if (static_cast<int>(isa) > static_cast<int>(best)) {
+        isa = best;
+    }
+    selectedIsa.store(static_cast<int>(isa), std::memory_order_relaxed);
+    return isa;
+}
+
+const char* kernelIsaName(KernelIsa isa) {
+    switch (isa) {
+        case KernelIsa::AVX512:
+            return "AVX-512BW";
+        case KernelIsa::AVX2:
+            return "AVX2";
+        default:
+            return "scalar";
+    }
+}
+
+StateCounts progressAndCountStatesScalar(std::uint8_t* states, std::uint8_t* daysLeft, std::size_t count) {
+    StateCounts counts = {0, 0, 0};
+    progressRange(states, daysLeft, 0, count, counts);
+    counts.recovered = static_cast<std::int64_t>(count) - counts.susceptible - counts.infected;
+    return counts;
+}
+
+StateCounts countStatesScalar(const std::uint8_t* states, std::size_t count) {
+    StateCounts counts = {0, 0, 0};
+    countRange(states, 0, count, counts);
+    counts.recovered = static_cast<std::int64_t>(count) - counts.susceptible - counts.infected;
+    return counts;
+}
+
+StateCounts progressAndCountStates(std::uint8_t* states, std::uint8_t* daysLeft, std::size_t count) {
+    switch (getKernelIsa()) {
+#ifdef SIR_X86_KERNELS
+        case KernelIsa::AVX512:
+            return progressAndCountStatesAvx512(states, daysLeft, count);
+        case KernelIsa::AVX2:
+            return progressAndCountStatesAvx2(states, daysLeft, count);
+#endif
+        default:
+            return progressAndCountStatesScalar(states, daysLeft, count);
+    }
+}
+
+StateCounts countStates(const std::uint8_t* states, std::size_t count) {
+    switch (getKernelIsa()) {
+#ifdef SIR_X86_KERNELS
+        case KernelIsa::AVX512:
+            return countStatesAvx512(states, count);
+        case KernelIsa::AVX2:
+            return countStatesAvx2(states, count);
+#endif
+        default:
+            return countStatesScalar(states, count);
+    }
+}
+
+CompartmentCounts progressAndCountCompartmentsScalar(const TransitionTable& table, std::uint8_t* states,
+                                                     std::uint8_t* daysLeft, std::size_t count) {
+    CompartmentCounts counts = {{0}};
+    progressCompartmentRange(table, states, daysLeft, 0, count, counts);
+    return counts;
+}
+
+CompartmentCounts progressAndCountCompartments(const TransitionTable& table, std::uint8_t* states,
+                                               std::uint8_t* daysLeft, std::size_t count) {
+    if (table.sirLayout) {
+        StateCounts sir = progressAndCountStates(states, daysLeft, count);
+        CompartmentCounts counts = {{sir.susceptible, sir.infected, sir.recovered}};
+        return counts;
+    }
+    switch (getKernelIsa()) {
+#ifdef SIR_X86_KERNELS
+        case KernelIsa::AVX512:
+            return progressAndCountCompartmentsAvx512(table, states, daysLeft, count);
+        case KernelIsa::AVX2:
+            return progressAndCountCompartmentsAvx2(table, states, daysLeft, count);
+#endif
+        default:
+            return progressAndCountCompartmentsScalar(table, states, daysLeft, count);
+    }
+}
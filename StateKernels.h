@@ -0,0 +1,148 @@
+/**
+ * @file StateKernels.h
+ * @brief Vectorized state progression and counting kernels
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file declares the bulk kernels that advance and count the byte-per-agent
+ * state arrays held by Population. Each kernel has a portable scalar
+ * implementation plus AVX2 and AVX-512BW variants selected at runtime via CPUID.
+ * The SIR kernels hard-code S/I/R; the compartment kernels run any disease
+ * course compiled into a TransitionTable (see CompartmentModel).
+ */
+
+#ifndef STATE_KERNELS_H
+#define STATE_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Instruction set used by the state kernels
+ */
+enum class KernelIsa {
+    Scalar,     ///< Portable branch-free C++ loop
+    AVX2,       ///< 32 agents per iteration
+    AVX512      ///< 64 agents per iteration (requires AVX-512BW)
+};
+
+/**
+ * @brief Compartment totals produced by the counting kernels
+ */
+struct StateCounts {
+    std::int64_t susceptible;   ///< Agents in HealthState::Susceptible
+    std::int64_t infected;      ///< Agents in HealthState::Infected
+    std::int64_t recovered;     ///< Agents in HealthState::Recovered
+};
+
+/// Most compartments a transition table can hold (state codes index 16-byte lookup tables)
+const int MAX_COMPARTMENTS = 16;
+
+/**
+ * @brief Disease course compiled into per-state lookup tables
+ *
+ * Each day an agent in a timed compartment c counts its remaining days down
+ * by one; at zero it moves to next[c] and starts that compartment's countdown
+ * of entryDays[next[c]] days. Agents in untimed compartments are unchanged.
+ * Entries past `compartments` are untimed self-loops.
+ */
+struct TransitionTable {
+    std::uint8_t compartments;                  ///< Number of state codes in use
+    std::uint8_t timed[MAX_COMPARTMENTS];       ///< 0xFF for compartments with a countdown, else 0
+    std::uint8_t next[MAX_COMPARTMENTS];        ///< Compartment entered when the countdown ends
+    std::uint8_t entryDays[MAX_COMPARTMENTS];   ///< Countdown started on entering each compartment
+    bool sirLayout;                             ///< Codes 0/1/2 are S/I/R: the SIR kernels apply
+};
+
+/**
+ * @brief Number of agents in each compartment
+ */
+struct CompartmentCounts {
+    std::int64_t counts[MAX_COMPARTMENTS];   ///< counts[c] = agents with state code c
+};
+
+/**
+ * @brief Detects the widest kernel ISA supported by the running CPU
+ *
+ * @return KernelIsa::Scalar on non-x86 builds or when no vector extension is available
+ */
+KernelIsa detectKernelIsa();
+
+/**
+ * @brief Gets the ISA currently used by the dispatching kernels
+ *
+ * Defaults to detectKernelIsa() on first use.
+ */
+KernelIsa getKernelIsa();
+
+/**
+ * @brief Forces the dispatching kernels to a specific ISA
+ *
+ * Requests for an ISA the CPU does not support fall back to the best supported one,
+ * so this is safe to call with any value (e.g. to benchmark the scalar path).
+ *
+ * @param isa Requested instruction set
+ * @return The ISA actually selected
+ */
+KernelIsa setKernelIsa(KernelIsa isa);
+
+/**
+ * @brief Gets a printable name for an ISA
+ */
+const char* kernelIsaName(KernelIsa isa);
+
+/**
+ * @brief Advances every agent by one day and counts the resulting compartments
+ *
+ * For each infected agent the remaining-days counter is decremented; agents
+ * whose counter reaches zero become recovered. Susceptible and recovered agents
+ * are unchanged. This matches Person::updateState() applied element-wise.
+ *
+ * @param states HealthState codes, one byte per agent
+ * @param daysLeft Remaining infectious days, one byte per agent
+ * @param count Number of agents
+ * @return Compartment totals after progression
+ */
+StateCounts progressAndCountStates(std::uint8_t* states, std::uint8_t* daysLeft, std::size_t count);
+
+/**
+ * @brief Counts the agents in each compartment
+ *
+ * @param states HealthState codes, one byte per agent
+ * @param count Number of agents
+ * @return Compartment totals
+ */
+StateCounts countStates(const std::uint8_t* states, std::size_t count);
+
+/**
+ * @brief Advances every agent through a compiled disease course and counts the compartments
+ *
+ * Tables with the SIR layout run progressAndCountStates(); others use
+ * shuffle-based lookups of the table (16 compartments per register lane).
+ *
+ * @param table Compiled transitions
+ * @param states Compartment codes (< table.compartments), one byte per agent
+ * @param daysLeft Remaining days in the current compartment, one byte per agent
+ * @param count Number of agents
+ * @return Agents per compartment after progression
+ */
+CompartmentCounts progressAndCountCompartments(const TransitionTable& table, std::uint8_t* states,
+                                               std::uint8_t* daysLeft, std::size_t count);
+
+/**
+ * @brief Scalar reference implementation of progressAndCountCompartments() (any table layout)
+ */
+CompartmentCounts progressAndCountCompartmentsScalar(const TransitionTable& table, std::uint8_t* states,
+                                                     std::uint8_t* daysLeft, std::size_t count);
+
+/**
+ * @brief Scalar reference implementation of progressAndCountStates()
+ */
+StateCounts progressAndCountStatesScalar(std::uint8_t* states, std::uint8_t* daysLeft, std::size_t count);
+
+/**
+ * @brief Scalar reference implementation of countStates()
+ */
+StateCounts countStatesScalar(const std::uint8_t* states, std::size_t count);
+
+#endif // STATE_KERNELS_H
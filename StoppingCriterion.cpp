@@ -0,0 +1,51 @@
+/**
+ * @file StoppingCriterion.cpp
+ * @brief Implementation of the built-in stopping criteria
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "StoppingCriterion.h"
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+AttackRateCriterion::AttackRateCriterion(double rate) : attackRate(rate) {
+    if (!(attackRate > 0.0 && attackRate <= 1.0)) {
+        throw std::invalid_argument("Stopping attack rate must be in (0, 1]");
+    }
+    std::ostringstream oss;
+    oss << "attack rate reached " << std::fixed << std::setprecision(1) << 100.0 * attackRate << "%";
+    reason = oss.str();
+}
+
+PrevalenceFloorCriterion::PrevalenceFloorCriterion(double floor, int floorDays)
+    : prevalence(floor), days(floorDays), daysBelow(0) {
+    if (!(prevalence > 0.0 && prevalence <= 1.0) || days < 1) {
+        throw std::invalid_argument("Prevalence floor must be in (0, 1] and last at least one day");
+    }
+    std::ostringstream oss;
+    oss << "prevalence below " << std::setprecision(3) << 100.0 * prevalence << "% for " << days
+        << (days == 1 ? " day" : " days");
+    reason = oss.str();
+}
+
+PeakDeclineCriterion::PeakDeclineCriterion(double fraction, int minimum)
+    : decline(fraction), minimumPeak(minimum), peak(0) {
+    if (!(decline > 0.0 && decline < 1.0) || minimumPeak < 0) {
+        throw std::invalid_argument("Peak decline must be in (0, 1) with a non-negative minimum peak");
+    }
+    std::ostringstream oss;
+    oss << "infected fell " << std::fixed << std::setprecision(1) << 100.0 * decline << "% below the peak";
+    reason = oss.str();
+}
+
+WallClockCriterion::WallClockCriterion(double budget) : seconds(budget) {
+    if (!(seconds > 0.0) || !std::isfinite(seconds)) {
+        throw std::invalid_argument("Wall-clock budget must be positive and finite");
+    }
+    std::ostringstream oss;
+    oss << "wall-clock budget of " << std::fixed << std::setprecision(2) << seconds << " s used";
+    reason = oss.str();
+}
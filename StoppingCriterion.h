@@ -0,0 +1,189 @@
+/**
+ * @file StoppingCriterion.h
+ * @brief Conditions ending a simulation run before its day limit
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the StoppingCriterion interface checked by SIRSimulation
+ * after every simulated day, and the built-in criteria: extinction, attack
+ * rate threshold, prevalence floor, peak decline and wall-clock budget.
+ */
+
+#ifndef STOPPING_CRITERION_H
+#define STOPPING_CRITERION_H
+
+#include "EpidemicStatistics.h"
+#include <string>
+
+/**
+ * @brief Condition checked after every simulated day
+ *
+ * Criteria see one EpidemicSnapshot per day and keep whatever running state
+ * they need (consecutive days, peak so far), so a check is a few comparisons.
+ */
+class StoppingCriterion {
+public:
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~StoppingCriterion() = default;
+
+    /**
+     * @brief Sees the counts after seeding, before the first simulated day
+     *
+     * The run cannot stop on day 0, so this only primes running state.
+     *
+     * @param initial Counts on day 0
+     */
+    virtual void start(const EpidemicSnapshot& /*initial*/) {}
+
+    /**
+     * @brief Updates the criterion with a day's counts
+     *
+     * @param snapshot Counts at the end of the day just simulated
+     * @return true if the run should stop after this day
+     */
+    virtual bool shouldStop(const EpidemicSnapshot& snapshot) = 0;
+
+    /**
+     * @brief Describes why the run stopped (valid after shouldStop() returned true)
+     *
+     * The text is built once, when the criterion is constructed, so reading
+     * it in a replicate loop does not allocate.
+     */
+    virtual const std::string& getReason() const = 0;
+
+    /**
+     * @brief Clears the running state for a new replicate
+     */
+    virtual void reset() {}
+};
+
+/**
+ * @brief Stops when no one is infected or exposed (the epidemic has ended)
+ */
+class ExtinctionCriterion : public StoppingCriterion {
+private:
+    std::string reason;             ///< Text returned by getReason()
+
+public:
+    ExtinctionCriterion() : reason("no infected or exposed individuals left") {}
+
+    bool shouldStop(const EpidemicSnapshot& snapshot) override {
+        return snapshot.infected == 0 && snapshot.exposed == 0;
+    }
+    const std::string& getReason() const override { return reason; }
+};
+
+/**
+ * @brief Stops once a fraction of the population has been infected
+ */
+class AttackRateCriterion : public StoppingCriterion {
+private:
+    double attackRate;              ///< Fraction of the population ever infected
+    std::string reason;             ///< Text returned by getReason()
+
+public:
+    /**
+     * @param attackRate Fraction of the population (0 < attackRate <= 1)
+     * @throws std::invalid_argument if attackRate is out of range
+     */
+    explicit AttackRateCriterion(double attackRate);
+
+    bool shouldStop(const EpidemicSnapshot& snapshot) override {
+        return static_cast<double>(snapshot.getAffected()) >= attackRate * snapshot.populationSize;
+    }
+    const std::string& getReason() const override { return reason; }
+};
+
+/**
+ * @brief Stops when prevalence stays below a floor for consecutive days
+ *
+ * Prevalence counts infected and exposed individuals, so a latent wave does
+ * not end the run.
+ */
+class PrevalenceFloorCriterion : public StoppingCriterion {
+private:
+    double prevalence;              ///< Floor as a fraction of the population
+    int days;                       ///< Consecutive days required
+    int daysBelow;                  ///< Current run of days below the floor
+    std::string reason;             ///< Text returned by getReason()
+
+public:
+    /**
+     * @param prevalence Floor as a fraction of the population (0 < prevalence <= 1)
+     * @param days Consecutive days below the floor (>= 1)
+     * @throws std::invalid_argument if a parameter is out of range
+     */
+    PrevalenceFloorCriterion(double prevalence, int days);
+
+    bool shouldStop(const EpidemicSnapshot& snapshot) override {
+        const double active = static_cast<double>(snapshot.infected) + snapshot.exposed;
+        daysBelow = active < prevalence * snapshot.populationSize ? daysBelow + 1 : 0;
+        return daysBelow >= days;
+    }
+    const std::string& getReason() const override { return reason; }
+    void reset() override { daysBelow = 0; }
+};
+
+/**
+ * @brief Stops once the infected count has fallen a margin below its peak
+ *
+ * The day-0 count is the first candidate peak, so a run seeded above its
+ * equilibrium that only declines still stops. Peaks below minimumPeak are
+ * ignored, so the stochastic fade of a handful of seeds is not taken for a
+ * passed peak. Only the first wave is seen: the
+ * run stops on its decline even if immunity loss or a schedule brings
+ * another one.
+ */
+class PeakDeclineCriterion : public StoppingCriterion {
+private:
+    double decline;                 ///< Fraction of the peak the count must drop by
+    int minimumPeak;                ///< Smallest peak that counts
+    int peak;                       ///< Highest infected count so far
+    std::string reason;             ///< Text returned by getReason() (the peak is in getPeak())
+
+public:
+    /**
+     * @param decline Fraction of the peak (0 < decline < 1); 0.5 stops at half the peak
+     * @param minimumPeak Smallest infected count accepted as a peak (>= 0)
+     * @throws std::invalid_argument if a parameter is out of range
+     */
+    PeakDeclineCriterion(double decline, int minimumPeak);
+
+    bool shouldStop(const EpidemicSnapshot& snapshot) override {
+        if (snapshot.infected > peak) {
+            peak = snapshot.infected;
+            return false;
+        }
+        return peak > 0 && peak >= minimumPeak && snapshot.infected <= (1.0 - decline) * peak;
+    }
+    void start(const EpidemicSnapshot& initial) override { peak = initial.infected; }
+    const std::string& getReason() const override { return reason; }
+    void reset() override { peak = 0; }
+    int getPeak() const { return peak; }
+};
+
+/**
+ * @brief Stops once the run has used its wall-clock budget
+ *
+ * Where a run stops then depends on the machine; sweeps use it to bound the
+ * cost of a replicate, not to define its outcome.
+ */
+class WallClockCriterion : public StoppingCriterion {
+private:
+    double seconds;                 ///< Budget in seconds
+    std::string reason;             ///< Text returned by getReason()
+
+public:
+    /**
+     * @param seconds Budget (> 0)
+     * @throws std::invalid_argument if seconds is not positive and finite
+     */
+    explicit WallClockCriterion(double seconds);
+
+    bool shouldStop(const EpidemicSnapshot& snapshot) override { return snapshot.elapsedSeconds >= seconds; }
+    const std::string& getReason() const override { return reason; }
+};
+
+#endif // STOPPING_CRITERION_H
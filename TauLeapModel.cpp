@@ -0,0 +1,161 @@
+/**
+ * @file TauLeapModel.cpp
+ * @brief Implementation of the adaptive tau-leaping SIR engine
+ * @author Scientific Computing Team
+ * @date 2025
+ */
+
+#include "TauLeapModel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/// Leaps expected to fire fewer events than this are replaced by exact SSA steps
+const double EXACT_EVENT_THRESHOLD = 10.0;
+
+/**
+ * @brief Draws a Poisson variate, clamped to an upper limit
+ */
+long long poissonAtMost(std::mt19937_64& rng, double mean, long long limit) {
+    if (mean <= 0.0 || limit <= 0) {
+        return 0;
+    }
+    std::poisson_distribution<long long> poisson(mean);
+    return std::min(poisson(rng), limit);
+}
+
+} // namespace
+
+TauLeapModel::TauLeapModel(int populationSize)
+    : size(populationSize), day(0), time(0.0),
+      countSusceptible(populationSize), countInfected(0), countRecovered(0),
+      infectionRate(0.0), recoveryRate(0.0), epsilon(0.03),
+      leapCount(0), exactCount(0) {
+    if (populationSize <= 0) {
+        throw std::invalid_argument("Population size must be positive");
+    }
+}
+
+void TauLeapModel::setInfectionRate(double beta) {
+    if (beta < 0.0) {
+        throw std::invalid_argument("Infection rate must be non-negative");
+    }
+    infectionRate = beta;
+}
+
+void TauLeapModel::setRecoveryRate(double gamma) {
+    if (gamma < 0.0) {
+        throw std::invalid_argument("Recovery rate must be non-negative");
+    }
+    recoveryRate = gamma;
+}
+
+void TauLeapModel::setEpsilon(double tolerance) {
+    if (tolerance <= 0.0 || tolerance >= 1.0) {
+        throw std::invalid_argument("Tau-leap tolerance must be between 0 and 1");
+    }
+    epsilon = tolerance;
+}
+
+void TauLeapModel::setSeed(unsigned int seed) {
+    rng.seed(seed);
+}
+
+void TauLeapModel::reset(unsigned int seed) {
+    day = 0;
+    time = 0.0;
+    countSusceptible = size;
+    countInfected = 0;
+    countRecovered = 0;
+    leapCount = 0;
+    exactCount = 0;
+    setSeed(seed);
+}
+
+void TauLeapModel::infectRandomPerson() {
+    if (countSusceptible > 0) {
+        countSusceptible--;
+        countInfected++;
+    }
+}
+
+double TauLeapModel::selectTau(double infectionPropensity, double recoveryPropensity) const {
+    // Both species take part in the second-order infection channel, so g_i = 2
+    const double boundSusceptible = std::max(epsilon * countSusceptible / 2.0, 1.0);
+    const double boundInfected = std::max(epsilon * countInfected / 2.0, 1.0);
+
+    // Expected drift and variance of each species per unit time
+    const double driftSusceptible = infectionPropensity;
+    const double varianceSusceptible = infectionPropensity;
+    const double driftInfected = std::fabs(infectionPropensity - recoveryPropensity);
+    const double varianceInfected = infectionPropensity + recoveryPropensity;
+
+    double tau = std::numeric_limits<double>::infinity();
+    if (driftSusceptible > 0.0) {
+        tau = std::min(tau, boundSusceptible / driftSusceptible);
+        tau = std::min(tau, boundSusceptible * boundSusceptible / varianceSusceptible);
+    }
+    if (driftInfected > 0.0) {
+        tau = std::min(tau, boundInfected / driftInfected);
+    }
+    if (varianceInfected > 0.0) {
+        tau = std::min(tau, boundInfected * boundInfected / varianceInfected);
+    }
+    return tau;
+}
+
+void TauLeapModel::setTransmissionParameters(float probability, double contacts) {
+    setInfectionRate(static_cast<double>(probability) * contacts);
+}
+
+void TauLeapModel::simulateOneDay() {
+    const double dayEnd = day + 1.0;
+    const double infectionScale = infectionRate / size;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    while (countInfected > 0 && time < dayEnd) {
+        double infectionPropensity = infectionScale * countSusceptible * countInfected;
+        double recoveryPropensity = recoveryRate * countInfected;
+        double totalPropensity = infectionPropensity + recoveryPropensity;
+        if (totalPropensity <= 0.0) {
+            break;
+        }
+
+        double tau = selectTau(infectionPropensity, recoveryPropensity);
+        if (tau * totalPropensity < EXACT_EVENT_THRESHOLD) {
+            // Leaping would fire only a handful of events: take one exact SSA step
+            double waiting = -std::log(1.0 - uniform(rng)) / totalPropensity;
+            if (time + waiting >= dayEnd) {
+                break;
+            }
+            time += waiting;
+            if (uniform(rng) * totalPropensity < infectionPropensity) {
+                countSusceptible--;
+                countInfected++;
+            } else {
+                countInfected--;
+                countRecovered++;
+            }
+            exactCount++;
+            continue;
+        }
+
+        bool reachesDayEnd = time + tau >= dayEnd;
+        if (reachesDayEnd) {
+            tau = dayEnd - time;
+        }
+        long long infections = poissonAtMost(rng, infectionPropensity * tau, countSusceptible);
+        long long recoveries = poissonAtMost(rng, recoveryPropensity * tau, countInfected);
+        countSusceptible -= static_cast<int>(infections);
+        countInfected += static_cast<int>(infections - recoveries);
+        countRecovered += static_cast<int>(recoveries);
+        time = reachesDayEnd ? dayEnd : time + tau;
+        leapCount++;
+    }
+
+    time = dayEnd;
+    day++;
+}
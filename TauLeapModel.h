@@ -0,0 +1,123 @@
+/**
+ * @file TauLeapModel.h
+ * @brief Adaptive tau-leaping SIR engine for very large populations
+ * @author Scientific Computing Team
+ * @date 2025
+ *
+ * This file defines the TauLeapModel class which approximates the SIR Markov
+ * jump process by firing Poisson-distributed batches of reactions per leap.
+ */
+
+#ifndef TAU_LEAP_MODEL_H
+#define TAU_LEAP_MODEL_H
+
+#include "EpidemicModel.h"
+#include <random>
+
+/**
+ * @brief Tau-leaping solver on aggregate S/I/R counts
+ *
+ * Uses the same reaction channels and rates as GillespieModel
+ * (infection beta * S * I / N, recovery gamma * I) but advances time in leaps
+ * of length tau, during which the number of firings of each channel is drawn
+ * from a Poisson distribution. The leap length is chosen adaptively with the
+ * Cao-Gillespie-Petzold bound so that no propensity changes by more than a
+ * relative tolerance epsilon during a leap. When the bound drops below a few
+ * expected events (early outbreak and extinction tail) the solver falls back
+ * to exact SSA events, so small counts are simulated without leap error.
+ *
+ * Cost per day is independent of the population size, making national-scale
+ * populations (N ~ 10^9) run in milliseconds.
+ *
+ * @note Firings are clamped to the available S and I so counts never go negative.
+ */
+class TauLeapModel : public EpidemicModel {
+private:
+    int size;                  ///< Total population size N
+    int day;                   ///< Current simulation day
+    double time;               ///< Continuous simulation time in days
+
+    int countSusceptible;      ///< Number of susceptible individuals
+    int countInfected;         ///< Number of infected individuals
+    int countRecovered;        ///< Number of recovered individuals
+
+    double infectionRate;      ///< Transmission rate beta (per day)
+    double recoveryRate;       ///< Recovery rate gamma (per day)
+    double epsilon;            ///< Leap-size error control tolerance
+    long long leapCount;       ///< Number of tau leaps taken
+    long long exactCount;      ///< Number of exact SSA events fired
+
+    std::mt19937_64 rng;       ///< Random number generator
+
+    /**
+     * @brief Selects the leap length from the current propensities
+     *
+     * @param infectionPropensity Current infection propensity a1
+     * @param recoveryPropensity Current recovery propensity a2
+     * @return Largest tau satisfying the epsilon bound
+     */
+    double selectTau(double infectionPropensity, double recoveryPropensity) const;
+
+public:
+    /**
+     * @brief Constructor with an all-susceptible population
+     *
+     * @param populationSize Number of individuals (must be > 0)
+     * @throws std::invalid_argument if populationSize <= 0
+     */
+    explicit TauLeapModel(int populationSize);
+
+    /**
+     * @brief Sets the transmission rate beta (contactsPerDay * infectionProbability)
+     *
+     * @param beta Rate per day (must be >= 0)
+     */
+    void setInfectionRate(double beta);
+
+    /**
+     * @brief Sets the recovery rate gamma (1 / infectionDuration)
+     *
+     * @param gamma Rate per day (must be >= 0)
+     */
+    void setRecoveryRate(double gamma);
+
+    /**
+     * @brief Sets the leap error tolerance
+     *
+     * Smaller values give shorter, more accurate leaps. The default of 0.03 is
+     * the value commonly used in the tau-leaping literature.
+     *
+     * @param tolerance Relative tolerance (0 < tolerance < 1)
+     */
+    void setEpsilon(double tolerance);
+
+    void setSeed(unsigned int seed) override;
+    void reset(unsigned int seed) override;
+
+    /**
+     * @brief Moves one susceptible individual to the infected compartment
+     */
+    void infectRandomPerson() override;
+
+    /**
+     * @brief Sets the infection rate to infectionProbability * contactsPerDay
+     */
+    void setTransmissionParameters(float infectionProbability, double contactsPerDay) override;
+
+    /**
+     * @brief Leaps (or steps exactly) up to the next whole day
+     */
+    void simulateOneDay() override;
+
+    int getCurrentDay() const override { return day; }
+    int getPopulationSize() const override { return size; }
+    int getSusceptibleCount() const override { return countSusceptible; }
+    int getInfectedCount() const override { return countInfected; }
+    int getRecoveredCount() const override { return countRecovered; }
+
+    double getEpsilon() const { return epsilon; }
+    long long getLeapCount() const { return leapCount; }
+    long long getExactEventCount() const { return exactCount; }
+};
+
+#endif // TAU_LEAP_MODEL_H